@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "stsafe_a110/stsafe_a110.h"
+#include "stsafe_a110/stsafe_a110_dispatcher.h"
+#include "stsafe_a110/stsafe_a110_pool.h"
+
+using namespace utest::v1;
+
+/* Longest time a nested operation may take before it is considered deadlocked */
+#define NESTED_TIMEOUT_MS 1000
+
+static sixtron::STSafeA110 se;
+static sixtron::STSafeA110Dispatcher dispatcher;
+static sixtron::STSafeA110Pool pool;
+
+static Semaphore nested_done(0, 1);
+static int nested_result;
+static uint8_t random_1[16];
+static uint8_t random_2[16];
+
+static int nested_command()
+{
+    return se.generate_random(random_2);
+}
+
+static int outer_command()
+{
+    /* Runs on the worker thread, which must not wait for its own queue */
+    return dispatcher.call(callback(nested_command));
+}
+
+static void on_random(int result)
+{
+    /* Runs on the dispatcher thread of the only device, which the blocking operation selects too */
+    nested_result = (result == 0) ? pool.generate_random(random_2, sizeof(random_2)) : result;
+    nested_done.release();
+}
+
+static void test_call_from_command()
+{
+    TEST_ASSERT_EQUAL(0, dispatcher.call(callback(outer_command)));
+}
+
+static void test_blocking_submit_from_completion()
+{
+    nested_result = -1;
+    TEST_ASSERT_EQUAL(0, pool.generate_random(random_1, sizeof(random_1), callback(on_random)));
+    TEST_ASSERT_TRUE(nested_done.try_acquire_for(Kernel::Clock::duration_u32(NESTED_TIMEOUT_MS)));
+    TEST_ASSERT_EQUAL(0, nested_result);
+}
+
+static utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+
+    if ((se.init() != 0) || (dispatcher.start() != 0) || (pool.add(&se, &dispatcher) != 0)) {
+        return STATUS_ABORT;
+    }
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("dispatcher call from a command", test_call_from_command),
+    Case("pool blocking submit from a completion", test_blocking_submit_from_completion),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
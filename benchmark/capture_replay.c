@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+ * Record and replay captures of the bus calls of the middleware, see stsafea_capture.h.
+ *
+ *     capture_replay record trace.bin
+ *         captures a session of commands (echo, random, read, update, key pair, signature,
+ *         verification, key establishment) run against the simulator
+ *     capture_replay replay trace.bin [rounds]
+ *         replays a capture, of the simulator or of a device, through the middleware at full
+ *         speed and prints for each command, as CSV, the latency and NACKs recorded and the mean
+ *         host time of the replays
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_capture.h"
+#include "stsafea_core.h"
+#include "stsafea_interface_linux.h"
+#include "stsafea_replay.h"
+#include "stsafea_simulator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_MAX_LENGTH (1024U * 1024U)
+#define EXCHANGE_MAX_NUMBER 4096U
+
+static StSafeA_Handle_t handle;
+static uint8_t buffer[STSAFEA_BUFFER_MAX_SIZE];
+static uint8_t trace[TRACE_MAX_LENGTH];
+static stsafea_replay_exchange_t exchanges[EXCHANGE_MAX_NUMBER];
+static uint64_t replay_ns[EXCHANGE_MAX_NUMBER];
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static int session(void)
+{
+    uint8_t data[64];
+    uint8_t out[STSAFEA_BUFFER_DATA_CONTENT_SIZE];
+    uint8_t x[STSAFEA_XYRS_ECDSA_SHA256_LENGTH], y[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+    uint8_t r[STSAFEA_XYRS_ECDSA_SHA256_LENGTH], s[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+    uint8_t digest[STSAFEA_SHA_256_LENGTH];
+    uint8_t point_representation;
+    StSafeA_LVBuffer_t response = { 0, out };
+    StSafeA_LVBuffer_t update = { sizeof(data), data };
+    StSafeA_LVBuffer_t pub_x = { 0, x };
+    StSafeA_LVBuffer_t pub_y = { 0, y };
+    StSafeA_LVBuffer_t sign_r = { 0, r };
+    StSafeA_LVBuffer_t sign_s = { 0, s };
+    StSafeA_LVBuffer_t hash = { sizeof(digest), digest };
+    StSafeA_VerifySignatureBuffer_t verification;
+    StSafeA_SharedSecretBuffer_t secret;
+
+    memset(data, 0xA5, sizeof(data));
+    memset(digest, 0x5A, sizeof(digest));
+    secret.SharedKey.Data = out;
+
+    if ((StSafeA_Echo(&handle, data, sizeof(data), &response, STSAFEA_MAC_NONE) != STSAFEA_OK)
+            || (StSafeA_GenerateRandom(
+                        &handle, STSAFEA_EPHEMERAL_RND, 32, &response, STSAFEA_MAC_NONE)
+                    != STSAFEA_OK)
+            || (StSafeA_Update(&handle, 0, 0, 0, 0, 1, 0, &update, STSAFEA_MAC_NONE) != STSAFEA_OK)
+            || (StSafeA_Read(&handle,
+                        0,
+                        0,
+                        0,
+                        1,
+                        0,
+                        sizeof(data),
+                        sizeof(data),
+                        &response,
+                        STSAFEA_MAC_NONE)
+                    != STSAFEA_OK)
+            || (StSafeA_GenerateKeyPair(&handle,
+                        STSAFEA_KEY_SLOT_1,
+                        0xFFFF,
+                        0,
+                        STSAFEA_PRVKEY_MODOPER_AUTHFLAG_MSG_DGST_SIGNEN,
+                        STSAFEA_NIST_P_256,
+                        STSAFEA_XYRS_ECDSA_SHA256_LENGTH,
+                        &point_representation,
+                        &pub_x,
+                        &pub_y,
+                        STSAFEA_MAC_NONE)
+                    != STSAFEA_OK)
+            || (StSafeA_GenerateSignature(&handle,
+                        STSAFEA_KEY_SLOT_1,
+                        digest,
+                        STSAFEA_SHA_256,
+                        STSAFEA_XYRS_ECDSA_SHA256_LENGTH,
+                        &sign_r,
+                        &sign_s,
+                        STSAFEA_MAC_NONE,
+                        STSAFEA_ENCRYPTION_NONE)
+                    != STSAFEA_OK)
+            || (StSafeA_VerifyMessageSignature(&handle,
+                        STSAFEA_NIST_P_256,
+                        &pub_x,
+                        &pub_y,
+                        &sign_r,
+                        &sign_s,
+                        &hash,
+                        &verification,
+                        STSAFEA_MAC_NONE)
+                    != STSAFEA_OK)
+            || (StSafeA_EstablishKey(&handle,
+                        STSAFEA_KEY_SLOT_1,
+                        &pub_x,
+                        &pub_y,
+                        STSAFEA_XYRS_ECDSA_SHA256_LENGTH,
+                        &secret,
+                        STSAFEA_MAC_NONE,
+                        STSAFEA_ENCRYPTION_NONE)
+                    != STSAFEA_OK)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int record(const char *path)
+{
+    static stsafea_sim_t sim;
+    stsafea_linux_bus_t bus;
+    stsafea_capture_t capture;
+    FILE *file;
+    int ret;
+
+    stsafea_sim_init(&sim, 1);
+    stsafea_sim_attach(&sim, &bus);
+    if (StSafeA_InitDevice(&handle, buffer, &bus, 0) != STSAFEA_OK) {
+        return 1;
+    }
+
+    stsafea_capture_start(&capture, &handle, trace, sizeof(trace));
+    ret = session();
+    stsafea_capture_stop(&capture, &handle);
+    stsafea_sim_deinit(&sim);
+    if ((ret != 0) || (capture.dropped != 0U)) {
+        fprintf(stderr, "session failed\n");
+        return 1;
+    }
+
+    file = fopen(path, "wb");
+    if ((file == NULL) || (fwrite(trace, 1, capture.length, file) != capture.length)) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    fclose(file);
+    fprintf(stderr, "%lu bytes\n", (unsigned long)capture.length);
+
+    return 0;
+}
+
+static int replay(const char *path, uint32_t rounds)
+{
+    static stsafea_replay_t replay;
+    stsafea_linux_bus_t bus = { -1, NULL, NULL };
+    FILE *file = fopen(path, "rb");
+    size_t length;
+    int32_t number;
+    uint32_t mismatches = 0;
+    uint32_t failures = 0;
+
+    if (file == NULL) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+    length = fread(trace, 1, sizeof(trace), file);
+    fclose(file);
+
+    number = stsafea_replay_load(trace, (uint32_t)length, exchanges, EXCHANGE_MAX_NUMBER);
+    if (number < 0) {
+        fprintf(stderr, "malformed capture\n");
+        return 1;
+    }
+    if (StSafeA_InitDevice(&handle, buffer, &bus, 0) != STSAFEA_OK) {
+        return 1;
+    }
+
+    memset(replay_ns, 0, sizeof(replay_ns));
+    for (uint32_t round = 0; round < rounds; round++) {
+        stsafea_replay_attach(&replay, &handle, exchanges, (uint32_t)number);
+        for (int32_t i = 0; i < number; i++) {
+            uint64_t start = now_ns();
+            StSafeA_ResponseCode_t status = stsafea_replay_next(&replay, &handle);
+            replay_ns[i] += now_ns() - start;
+            /* The middleware must return the status the device answered */
+            if ((exchanges[i].response == NULL)
+                    || (status
+                            != (StSafeA_ResponseCode_t)(exchanges[i].response[0]
+                                    & ~STSAFEA_CMD_HEADER_RMACEN))) {
+                failures++;
+            }
+        }
+        mismatches += replay.mismatches;
+    }
+
+    printf("command,header,recorded_latency_us,send_nacks,recv_nacks,replay_ns\n");
+    for (int32_t i = 0; i < number; i++) {
+        printf("%ld,0x%02X,%lu,%u,%u,%.0f\n",
+                (long)i,
+                exchanges[i].command[0],
+                (unsigned long)exchanges[i].latency_us,
+                exchanges[i].send_nacks,
+                exchanges[i].recv_nacks,
+                (double)replay_ns[i] / rounds);
+    }
+
+    if ((mismatches != 0U) || (failures != 0U)) {
+        fprintf(stderr,
+                "%lu mismatches, %lu failures\n",
+                (unsigned long)mismatches,
+                (unsigned long)failures);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc == 3) && (strcmp(argv[1], "record") == 0)) {
+        return record(argv[2]);
+    }
+    if (((argc == 3) || (argc == 4)) && (strcmp(argv[1], "replay") == 0)) {
+        uint32_t rounds = (argc == 4) ? (uint32_t)strtoul(argv[3], NULL, 10) : 1U;
+        return replay(argv[2], (rounds != 0U) ? rounds : 1U);
+    }
+
+    fprintf(stderr, "usage: %s record|replay trace.bin [rounds]\n", argv[0]);
+
+    return 2;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+ * Host microbenchmark of the CRC16-X25 engine selected with STSAFEA_CRC16X25_ENGINE, over frame
+ * lengths from 1 to 507 bytes. The result, computed at once or accumulated in parts, is checked
+ * against a bit-wise reference first.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_crc16x25.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAME_MAX_LENGTH 507
+#define ITERATIONS 2000
+
+static const char *engine_name(void)
+{
+    switch (STSAFEA_CRC16X25_ENGINE) {
+        case STSAFEA_CRC16X25_ENGINE_TABLE:
+            return "table";
+        case STSAFEA_CRC16X25_ENGINE_SLICING_4:
+            return "slicing-by-4";
+        case STSAFEA_CRC16X25_ENGINE_SLICING_8:
+            return "slicing-by-8";
+        case STSAFEA_CRC16X25_ENGINE_CLMUL:
+            return "clmul";
+        default:
+            return "unknown";
+    }
+}
+
+static uint16_t reference(uint8_t header, const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (int32_t i = -1; i < length; i++) {
+        crc ^= (i < 0) ? header : data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1U) ? ((crc >> 1) ^ 0x8408U) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+int main(void)
+{
+    static uint8_t frame[FRAME_MAX_LENGTH + 8];
+    static uint8_t copy[FRAME_MAX_LENGTH];
+    static const uint8_t check[] = { '2', '3', '4', '5', '6', '7', '8', '9' };
+    static const uint16_t lengths[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, FRAME_MAX_LENGTH };
+    volatile uint16_t sink = 0;
+    uint16_t crc;
+    uint64_t start, elapsed;
+
+    stsafea_crc16x25_init();
+
+    for (uint32_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)rand();
+    }
+
+    /* CRC-16/X-25 check value of "123456789" */
+    crc = stsafea_crc16x25_compute('1', check, sizeof(check)) ^ 0xFFFFU;
+    if (crc != 0x906EU) {
+        printf("%s: wrong check value\n", engine_name());
+        return 1;
+    }
+
+    /* Every length, at every alignment */
+    for (uint16_t length = 0; length <= FRAME_MAX_LENGTH; length++) {
+        for (uint8_t offset = 0; offset < 8; offset++) {
+            if (stsafea_crc16x25_compute(frame[offset], &frame[offset + 1], length)
+                    != reference(frame[offset], &frame[offset + 1], length)) {
+                printf("%s: mismatch for %u bytes at offset %u\n", engine_name(), length, offset);
+                return 1;
+            }
+        }
+    }
+
+    /* Accumulated in two parts while copying, as done when a command frame is built */
+    for (uint16_t length = 0; length <= FRAME_MAX_LENGTH; length++) {
+        uint16_t split = length / 3U;
+        memset(copy, 0, sizeof(copy));
+        crc = stsafea_crc16x25_update(0xFFFF, NULL, frame, 1);
+        crc = stsafea_crc16x25_update(crc, copy, &frame[1], split);
+        crc = stsafea_crc16x25_update(crc, &copy[split], &frame[1 + split], length - split);
+        if ((crc != reference(frame[0], &frame[1], length))
+                || (memcmp(copy, &frame[1], length) != 0)) {
+            printf("%s: accumulation mismatch for %u bytes\n", engine_name(), length);
+            return 1;
+        }
+    }
+
+    printf("%-14s %8s %10s\n", "engine", "length", "ns/frame");
+    for (uint8_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); n++) {
+        uint16_t length = lengths[n];
+        start = now_ns();
+        for (uint32_t i = 0; i < ITERATIONS; i++) {
+            sink ^= stsafea_crc16x25_compute(frame[0], &frame[1], length);
+        }
+        elapsed = now_ns() - start;
+        printf("%-14s %8u %10.1f\n", engine_name(), length, (double)elapsed / ITERATIONS);
+    }
+
+    start = now_ns();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        for (uint16_t length = 1; length <= FRAME_MAX_LENGTH; length++) {
+            sink ^= stsafea_crc16x25_compute(frame[0], &frame[1], length);
+        }
+    }
+    elapsed = now_ns() - start;
+    printf("%-14s %8s %10.1f MB/s over 1-%u byte frames\n",
+            engine_name(),
+            "all",
+            ((double)ITERATIONS * FRAME_MAX_LENGTH * (FRAME_MAX_LENGTH + 1) / 2) * 1000.0 / (double)elapsed,
+            FRAME_MAX_LENGTH);
+
+    (void)sink;
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+ * Host test of the host C-MAC sequence counter tracked by the middleware, built without
+ * STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT and run against the simulator, which refuses a
+ * C-MAC computed with another counter than its own. The host crypto functions below produce the
+ * C-MACs of the simulator, see stsafea_sim_host_cmac().
+ *
+ * Echo commands with a host C-MAC check that the counter is queried once and then tracked, and
+ * that it is queried again after a command failing to be sent, a response failing to be read
+ * (the device having processed the command) and a C-MAC refused by the device.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_core.h"
+#include "stsafea_interface_linux.h"
+#include "stsafea_simulator.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if (STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
+#error "build with -DSTSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT=0U"
+#endif
+
+#define INITIAL_COUNTER 0x012345U
+#define TRACKED_COMMANDS 8U
+#define ECHO_LENGTH 16U
+
+typedef struct {
+    uint8_t blocks;
+    uint32_t counter; /* From the initial value, the first block */
+} mac_ctx_t;
+
+static StSafeA_Handle_t handle;
+static uint8_t buffer[STSAFEA_BUFFER_MAX_SIZE];
+static stsafea_sim_t sim;
+static mac_ctx_t mac_ctx;
+static uint8_t fail_writes;
+static uint8_t fail_reads;
+static uint32_t host_key_queries;
+
+int32_t StSafeA_HostKeys_Init(void)
+{
+    return 0;
+}
+
+void StSafeA_AES_MAC_Start(void **ppAesMacCtx)
+{
+    mac_ctx.blocks = 0U;
+    *ppAesMacCtx = &mac_ctx;
+}
+
+void StSafeA_AES_MAC_Update(uint8_t *pInData, uint16_t InDataLength, void *pAesMacCtx)
+{
+    mac_ctx_t *ctx = (mac_ctx_t *)pAesMacCtx;
+
+    if ((ctx->blocks == 0U) && (InDataLength >= 3U)) {
+        ctx->counter = ((uint32_t)pInData[0] << 16) | ((uint32_t)pInData[1] << 8) | pInData[2];
+    }
+    ctx->blocks++;
+}
+
+void StSafeA_AES_MAC_LastUpdate(uint8_t *pInData, uint16_t InDataLength, void *pAesMacCtx)
+{
+    StSafeA_AES_MAC_Update(pInData, InDataLength, pAesMacCtx);
+}
+
+void StSafeA_AES_MAC_Final(uint8_t *pOutMac, void **ppAesMacCtx)
+{
+    stsafea_sim_host_cmac(((mac_ctx_t *)*ppAesMacCtx)->counter, pOutMac);
+    *ppAesMacCtx = NULL;
+}
+
+/* Simulator transfers, failing while requested and counting the host key slot queries */
+static int transfer(void *transfer_ctx, struct i2c_msg *msgs, uint32_t msg_number)
+{
+    uint32_t i;
+
+    for (i = 0; i < msg_number; i++) {
+        if ((msgs[i].flags & I2C_M_RD) != 0U) {
+            if (fail_reads != 0U) {
+                errno = EIO;
+                return -1;
+            }
+        } else if (fail_writes != 0U) {
+            errno = EIO;
+            return -1;
+        } else if ((msgs[i].len >= 2U)
+                && ((msgs[i].buf[0] & STSAFEA_CMD_HEADER_CODE_MSK) == STSAFEA_CMD_QUERY)
+                && (msgs[i].buf[1] == STSAFEA_TAG_HOST_KEY_SLOT)) {
+            host_key_queries++;
+        }
+    }
+
+    return stsafea_sim_transfer(transfer_ctx, msgs, msg_number);
+}
+
+static StSafeA_ResponseCode_t echo(void)
+{
+    uint8_t data[ECHO_LENGTH];
+    uint8_t out[ECHO_LENGTH + STSAFEA_MAC_LENGTH];
+    StSafeA_LVBuffer_t response = { 0, out };
+
+    memset(data, 0x5A, sizeof(data));
+
+    return StSafeA_Echo(&handle, data, sizeof(data), &response, STSAFEA_MAC_HOST_CMAC);
+}
+
+static int check(const char *name, int condition)
+{
+    printf("%-40s %s\n", name, condition ? "ok" : "FAILED");
+
+    return condition ? 0 : 1;
+}
+
+/* A command failing, then a command that must query the counter again and be accepted */
+static int check_recovery(const char *name, StSafeA_ResponseCode_t failed_status)
+{
+    uint32_t queries = host_key_queries;
+    uint32_t counter;
+
+    if (failed_status == STSAFEA_OK) {
+        return check(name, 0);
+    }
+    counter = sim.host_cmac_counter;
+
+    return check(name,
+            (echo() == STSAFEA_OK) && (host_key_queries == queries + 1U)
+                    && (sim.host_cmac_counter == counter + 1U));
+}
+
+int main(void)
+{
+    stsafea_linux_bus_t bus;
+    StSafeA_ResponseCode_t status;
+    uint32_t invalid_cmacs;
+    int failures = 0;
+    uint32_t i;
+
+    stsafea_sim_init(&sim, 1);
+    sim.host_key_present = 1U;
+    sim.host_cmac_counter = INITIAL_COUNTER;
+    stsafea_sim_attach(&sim, &bus);
+    bus.transfer = transfer;
+    if (StSafeA_InitDevice(&handle, buffer, &bus, 0) != STSAFEA_OK) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+
+    status = STSAFEA_OK;
+    for (i = 0; (i < TRACKED_COMMANDS) && (status == STSAFEA_OK); i++) {
+        status = echo();
+    }
+    failures += check("counter queried once, then tracked",
+            (status == STSAFEA_OK) && (host_key_queries == 1U)
+                    && (sim.host_cmac_counter == INITIAL_COUNTER + TRACKED_COMMANDS)
+                    && (sim.invalid_cmacs == 0U));
+
+    fail_writes = 1U;
+    status = echo();
+    fail_writes = 0U;
+    failures += check_recovery("counter queried after a send failure", status);
+
+    fail_reads = 1U;
+    status = echo();
+    fail_reads = 0U;
+    failures += check_recovery("counter queried after a receive failure", status);
+
+    invalid_cmacs = sim.invalid_cmacs;
+    sim.host_cmac_counter += 3U;
+    status = echo();
+    failures += check("C-MAC refused with another counter",
+            (status == STSAFEA_INVALID_CMAC) && (sim.invalid_cmacs == invalid_cmacs + 1U));
+    failures += check_recovery("counter queried after a refused C-MAC", status);
+
+    stsafea_sim_deinit(&sim);
+
+    return (failures == 0) ? 0 : 1;
+}
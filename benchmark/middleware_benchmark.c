@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/*
+ * Host benchmark of the middleware commands, run through stsafea_core.c, the Linux backend and the
+ * STSAFE-A110 simulator. Each operation is timed from the call to the return of the API, giving
+ * ops/s and p50/p99 latencies in CSV:
+ *
+ *     operation,iterations,ops_per_s,p50_us,p99_us
+ *
+ * With -z, the simulated processing times are zero and the latencies are those of the driver and
+ * of its wait strategy only. With -b, the p50 latencies are compared to those of a previous run
+ * and the benchmark fails if one of them regresses by more than the tolerance set with -t
+ * (percent).
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_core.h"
+#include "stsafea_interface_linux.h"
+#include "stsafea_simulator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_ITERATIONS 10000U
+#define DEFAULT_TOLERANCE 10.0
+#define OPERATION_NAME_LENGTH 32
+
+typedef struct {
+    const char *name;
+    uint32_t iterations; /* Default, for the simulated processing times */
+    StSafeA_ResponseCode_t (*run)(uint16_t size);
+    uint16_t size;
+} operation_t;
+
+typedef struct {
+    char name[OPERATION_NAME_LENGTH];
+    double p50_us;
+} baseline_t;
+
+static StSafeA_Handle_t handle;
+static uint8_t buffer[STSAFEA_BUFFER_MAX_SIZE];
+static uint8_t data[STSAFEA_BUFFER_DATA_CONTENT_SIZE];
+static uint8_t out[STSAFEA_BUFFER_DATA_CONTENT_SIZE];
+static uint8_t envelope[STSAFEA_BUFFER_DATA_CONTENT_SIZE];
+static uint8_t digest[STSAFEA_SHA_256_LENGTH];
+static uint8_t pub_x[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+static uint8_t pub_y[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+static uint8_t sign_r[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+static uint8_t sign_s[STSAFEA_XYRS_ECDSA_SHA256_LENGTH];
+static uint64_t latencies[MAX_ITERATIONS];
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static StSafeA_ResponseCode_t run_echo(uint16_t size)
+{
+    StSafeA_LVBuffer_t response = { 0, out };
+
+    return StSafeA_Echo(&handle, data, size, &response, STSAFEA_MAC_NONE);
+}
+
+static StSafeA_ResponseCode_t run_generate_random(uint16_t size)
+{
+    StSafeA_LVBuffer_t response = { 0, out };
+
+    return StSafeA_GenerateRandom(
+            &handle, STSAFEA_EPHEMERAL_RND, (uint8_t)size, &response, STSAFEA_MAC_NONE);
+}
+
+static StSafeA_ResponseCode_t run_read(uint16_t size)
+{
+    StSafeA_LVBuffer_t response = { 0, out };
+
+    return StSafeA_Read(&handle, 0, 0, 0, 1, 0, size, size, &response, STSAFEA_MAC_NONE);
+}
+
+static StSafeA_ResponseCode_t run_update(uint16_t size)
+{
+    StSafeA_LVBuffer_t update = { size, data };
+
+    return StSafeA_Update(&handle, 0, 0, 0, 0, 1, 0, &update, STSAFEA_MAC_NONE);
+}
+
+static StSafeA_ResponseCode_t run_generate_signature(uint16_t size)
+{
+    StSafeA_LVBuffer_t r = { 0, sign_r };
+    StSafeA_LVBuffer_t s = { 0, sign_s };
+
+    return StSafeA_GenerateSignature(&handle,
+            STSAFEA_KEY_SLOT_1,
+            digest,
+            STSAFEA_SHA_256,
+            size,
+            &r,
+            &s,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+}
+
+static StSafeA_ResponseCode_t run_verify_signature(uint16_t size)
+{
+    StSafeA_LVBuffer_t x = { size, pub_x };
+    StSafeA_LVBuffer_t y = { size, pub_y };
+    StSafeA_LVBuffer_t r = { size, sign_r };
+    StSafeA_LVBuffer_t s = { size, sign_s };
+    StSafeA_LVBuffer_t hash = { sizeof(digest), digest };
+    StSafeA_VerifySignatureBuffer_t verification;
+    StSafeA_ResponseCode_t status;
+
+    status = StSafeA_VerifyMessageSignature(
+            &handle, STSAFEA_NIST_P_256, &x, &y, &r, &s, &hash, &verification, STSAFEA_MAC_NONE);
+    if ((status == STSAFEA_OK) && (verification.SignatureValidity != 1U)) {
+        status = STSAFEA_INVALID_PARAMETER;
+    }
+
+    return status;
+}
+
+static StSafeA_ResponseCode_t run_establish_key(uint16_t size)
+{
+    StSafeA_LVBuffer_t x = { size, pub_x };
+    StSafeA_LVBuffer_t y = { size, pub_y };
+    StSafeA_SharedSecretBuffer_t secret;
+
+    secret.SharedKey.Data = out;
+
+    return StSafeA_EstablishKey(&handle,
+            STSAFEA_KEY_SLOT_1,
+            &x,
+            &y,
+            size,
+            &secret,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+}
+
+static StSafeA_ResponseCode_t run_wrap(uint16_t size)
+{
+    StSafeA_LVBuffer_t response = { 0, envelope };
+
+    return StSafeA_WrapLocalEnvelope(&handle,
+            STSAFEA_KEY_SLOT_0,
+            data,
+            size,
+            &response,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+}
+
+static StSafeA_ResponseCode_t run_unwrap(uint16_t size)
+{
+    StSafeA_LVBuffer_t response = { 0, out };
+
+    return StSafeA_UnwrapLocalEnvelope(&handle,
+            STSAFEA_KEY_SLOT_0,
+            envelope,
+            size + 8U,
+            &response,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+}
+
+static const operation_t operations[] = {
+    { "echo_16", 200, run_echo, 16 },
+    { "echo_256", 200, run_echo, 256 },
+    { "generate_random_32", 100, run_generate_random, 32 },
+    { "read_16", 200, run_read, 16 },
+    { "read_256", 200, run_read, 256 },
+    { "update_16", 100, run_update, 16 },
+    { "update_256", 100, run_update, 256 },
+    { "generate_signature", 20, run_generate_signature, STSAFEA_XYRS_ECDSA_SHA256_LENGTH },
+    { "verify_signature", 20, run_verify_signature, STSAFEA_XYRS_ECDSA_SHA256_LENGTH },
+    { "establish_key", 20, run_establish_key, STSAFEA_XYRS_ECDSA_SHA256_LENGTH },
+    { "wrap_64", 100, run_wrap, 64 },
+    { "unwrap_64", 100, run_unwrap, 64 },
+};
+
+#define OPERATION_NUMBER (sizeof(operations) / sizeof(operations[0]))
+
+/* Key pair in slot 1, a signature of the digest and an envelope key in slot 0 to work on */
+static int prepare(void)
+{
+    uint8_t point_representation;
+    StSafeA_LVBuffer_t x = { 0, pub_x };
+    StSafeA_LVBuffer_t y = { 0, pub_y };
+
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7U);
+    }
+    memset(digest, 0x5A, sizeof(digest));
+
+    if ((StSafeA_GenerateKeyPair(&handle,
+                 STSAFEA_KEY_SLOT_1,
+                 0xFFFF,
+                 0,
+                 STSAFEA_PRVKEY_MODOPER_AUTHFLAG_MSG_DGST_SIGNEN,
+                 STSAFEA_NIST_P_256,
+                 STSAFEA_XYRS_ECDSA_SHA256_LENGTH,
+                 &point_representation,
+                 &x,
+                 &y,
+                 STSAFEA_MAC_NONE)
+                != STSAFEA_OK)
+            || (run_generate_signature(STSAFEA_XYRS_ECDSA_SHA256_LENGTH) != STSAFEA_OK)
+            || (StSafeA_GenerateLocalEnvelopeKey(&handle,
+                        STSAFEA_KEY_SLOT_0,
+                        STSAFEA_KEY_TYPE_AES_128,
+                        NULL,
+                        0,
+                        STSAFEA_MAC_NONE)
+                    != STSAFEA_OK)
+            || (run_wrap(64) != STSAFEA_OK)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int compare_latencies(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted latencies, in us */
+static double percentile(uint32_t iterations, uint32_t percent)
+{
+    uint32_t rank = ((iterations * percent) + 99U) / 100U;
+
+    return (double)latencies[(rank > 0U) ? (rank - 1U) : 0U] / 1000.0;
+}
+
+static int load_baseline(const char *path, baseline_t *baseline, uint32_t *number)
+{
+    char line[128];
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL) {
+        return -1;
+    }
+
+    *number = 0;
+    while ((fgets(line, sizeof(line), file) != NULL) && (*number < OPERATION_NUMBER)) {
+        uint32_t iterations;
+        double ops, p99;
+        if (sscanf(line,
+                    "%31[^,],%u,%lf,%lf,%lf",
+                    baseline[*number].name,
+                    &iterations,
+                    &ops,
+                    &baseline[*number].p50_us,
+                    &p99)
+                == 5) {
+            (*number)++;
+        }
+    }
+    fclose(file);
+
+    return 0;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [-n iterations] [-z] [-o results.csv] [-b baseline.csv] [-t tolerance]\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    static stsafea_sim_t sim;
+    static baseline_t baseline[OPERATION_NUMBER];
+    stsafea_linux_bus_t bus;
+    uint32_t baseline_number = 0;
+    uint32_t iterations = 0;
+    int zero_busy = 0;
+    const char *output_path = NULL;
+    const char *baseline_path = NULL;
+    double tolerance = DEFAULT_TOLERANCE;
+    FILE *output = stdout;
+    int regressions = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:zo:b:t:")) != -1) {
+        switch (option) {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 10);
+                if ((iterations == 0U) || (iterations > MAX_ITERATIONS)) {
+                    fprintf(stderr, "iterations must be between 1 and %u\n", MAX_ITERATIONS);
+                    return 2;
+                }
+                break;
+            case 'z':
+                zero_busy = 1;
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 't':
+                tolerance = strtod(optarg, NULL);
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if ((baseline_path != NULL)
+            && (load_baseline(baseline_path, baseline, &baseline_number) != 0)) {
+        fprintf(stderr, "cannot read %s\n", baseline_path);
+        return 2;
+    }
+    if (output_path != NULL) {
+        output = fopen(output_path, "w");
+        if (output == NULL) {
+            fprintf(stderr, "cannot write %s\n", output_path);
+            return 2;
+        }
+    }
+
+    stsafea_sim_init(&sim, 1);
+    if (zero_busy) {
+        memset(sim.busy_us, 0, sizeof(sim.busy_us));
+        sim.busy_us_per_byte = 0;
+    }
+    stsafea_sim_attach(&sim, &bus);
+    if ((StSafeA_InitDevice(&handle, buffer, &bus, 0) != STSAFEA_OK) || (prepare() != 0)) {
+        fprintf(stderr, "cannot initialize the simulated device\n");
+        return 1;
+    }
+
+    fprintf(output, "operation,iterations,ops_per_s,p50_us,p99_us\n");
+    for (uint32_t n = 0; n < OPERATION_NUMBER; n++) {
+        const operation_t *operation = &operations[n];
+        uint32_t count = (iterations != 0U) ? iterations : operation->iterations;
+        uint64_t start, total = 0;
+        double p50;
+
+        for (uint32_t i = 0; i < count; i++) {
+            start = now_ns();
+            if (operation->run(operation->size) != STSAFEA_OK) {
+                fprintf(stderr, "%s failed\n", operation->name);
+                return 1;
+            }
+            latencies[i] = now_ns() - start;
+            total += latencies[i];
+        }
+        qsort(latencies, count, sizeof(latencies[0]), compare_latencies);
+        p50 = percentile(count, 50);
+
+        fprintf(output,
+                "%s,%u,%.1f,%.1f,%.1f\n",
+                operation->name,
+                count,
+                (double)count * 1e9 / (double)total,
+                p50,
+                percentile(count, 99));
+
+        for (uint32_t i = 0; i < baseline_number; i++) {
+            if ((strcmp(baseline[i].name, operation->name) == 0)
+                    && (p50 > baseline[i].p50_us * (1.0 + (tolerance / 100.0)))) {
+                fprintf(stderr,
+                        "%s: p50 %.1f us, baseline %.1f us\n",
+                        operation->name,
+                        p50,
+                        baseline[i].p50_us);
+                regressions++;
+            }
+        }
+    }
+
+    if (output != stdout) {
+        fclose(output);
+    }
+    stsafea_sim_deinit(&sim);
+
+    if (regressions != 0) {
+        fprintf(stderr, "%d regression(s) beyond %.0f%%\n", regressions, tolerance);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_interface_linux.h"
+#include "stsafea_crc16x25.h"
+#include "stsafea_service.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+
+#define STSAFEA_DEVICE_ADDRESS 0x20
+
+int stsafea_linux_bus_open(stsafea_linux_bus_t *bus, const char *path)
+{
+    bus->transfer = NULL;
+    bus->transfer_ctx = NULL;
+    bus->fd = open(path, O_RDWR | O_CLOEXEC);
+
+    return (bus->fd < 0) ? -1 : 0;
+}
+
+void stsafea_linux_bus_close(stsafea_linux_bus_t *bus)
+{
+    if (bus->fd >= 0) {
+        close(bus->fd);
+        bus->fd = -1;
+    }
+}
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000U) + ((uint64_t)now.tv_nsec / 1000U);
+}
+
+static void sleep_us(uint32_t us)
+{
+    struct timespec duration;
+
+    duration.tv_sec = us / 1000000U;
+    duration.tv_nsec = (long)(us % 1000000U) * 1000L;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &duration, &duration) == EINTR) { }
+}
+
+/* One I2C_RDWR transaction of a single message, DevAddr is the 8-bit address */
+static int32_t i2c_transfer(void *pBusCtx, uint16_t DevAddr, uint16_t flags, uint8_t *pData, uint16_t Length)
+{
+    stsafea_linux_bus_t *bus = (stsafea_linux_bus_t *)pBusCtx;
+    struct i2c_msg msg;
+    int ret;
+
+    if (bus == NULL) {
+        return STSAFEA_BUS_ERR;
+    }
+
+    msg.addr = DevAddr >> 1;
+    msg.flags = flags;
+    msg.len = Length;
+    msg.buf = pData;
+
+    if (bus->transfer != NULL) {
+        ret = bus->transfer(bus->transfer_ctx, &msg, 1);
+    } else {
+        struct i2c_rdwr_ioctl_data data;
+        data.msgs = &msg;
+        data.nmsgs = 1;
+        ret = ioctl(bus->fd, I2C_RDWR, &data);
+    }
+
+    if (ret < 0) {
+        /* The device NACKs its address while busy: report it so the caller polls again */
+        if ((errno == ENXIO) || (errno == EREMOTEIO) || (errno == EAGAIN)) {
+            return STSAFEA_BUS_NACK;
+        }
+        return STSAFEA_BUS_ERR;
+    }
+
+    return STSAFEA_BUS_OK;
+}
+
+static int32_t io_init(void *pBusCtx)
+{
+    (void)pBusCtx;
+    return 0;
+}
+
+static int32_t i2c_init(void *pBusCtx)
+{
+    return (pBusCtx != NULL) ? 0 : -1;
+}
+
+static int32_t i2c_deinit(void *pBusCtx)
+{
+    (void)pBusCtx;
+    return 0;
+}
+
+static int32_t i2c_send(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length)
+{
+    return i2c_transfer(pBusCtx, DevAddr, 0, pData, Length);
+}
+
+static int32_t i2c_recv(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length)
+{
+    uint64_t deadline = monotonic_us() + STSAFEA_LINUX_I2C_POLL_WINDOW_US;
+    int32_t ret;
+
+    /* Poll the response with a finer granularity than the millisecond steps of the middleware */
+    while (1) {
+        ret = i2c_transfer(pBusCtx, DevAddr, I2C_M_RD, pData, Length);
+        if ((ret != STSAFEA_BUS_NACK) || (monotonic_us() >= deadline)) {
+            return ret;
+        }
+        sleep_us(STSAFEA_LINUX_I2C_POLL_INTERVAL_US);
+    }
+}
+
+static int32_t crc16x25_init(void)
+{
+    return stsafea_crc16x25_init();
+}
+
+static uint32_t crc_compute(uint8_t *pData1, uint16_t Length1, uint8_t *pData2, uint16_t Length2)
+{
+    uint16_t crc;
+    (void)Length1;
+
+    if ((pData1 == NULL) || (pData2 == NULL)) {
+        return 0;
+    }
+
+    crc = stsafea_crc16x25_compute(pData1[0], pData2, Length2);
+    crc = (uint16_t)SWAP2BYTES(crc);
+    crc ^= 0xFFFFU;
+
+    return (uint32_t)crc;
+}
+
+static uint16_t crc_update(uint16_t Crc, uint8_t *pDest, const uint8_t *pSrc, uint16_t Length)
+{
+    return stsafea_crc16x25_update(Crc, pDest, pSrc, Length);
+}
+
+static void delay(uint32_t msDelay)
+{
+    sleep_us(msDelay * 1000U);
+}
+
+static uint32_t time_get_us(void)
+{
+    return (uint32_t)monotonic_us();
+}
+
+/* No portable cycle counter in user space, profiling times are nanoseconds */
+static uint32_t cycle_count(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint32_t)now.tv_sec * 1000000000U) + (uint32_t)now.tv_nsec;
+}
+
+int8_t StSafeA_HW_Probe(void *pCtx)
+{
+    STSAFEA_HW_t *HwCtx = (STSAFEA_HW_t *)pCtx;
+    HwCtx->IOInit = io_init;
+    HwCtx->BusInit = i2c_init;
+    HwCtx->BusDeInit = i2c_deinit;
+    HwCtx->BusSend = i2c_send;
+    HwCtx->BusRecv = i2c_recv;
+    /* i2c-dev cannot read a frame whose length is announced in its own header (I2C_M_RECV_LEN is
+     * limited to SMBus blocks), the middleware reads the expected length instead */
+    HwCtx->BusRecvFrame = NULL;
+    HwCtx->CrcInit = crc16x25_init;
+    HwCtx->CrcCompute = crc_compute;
+    HwCtx->CrcUpdate = crc_update;
+    HwCtx->TimeDelay = delay;
+    HwCtx->TimeGetUs = time_get_us;
+    HwCtx->CycleCount = cycle_count;
+    if (HwCtx->DevAddr == 0U) {
+        HwCtx->DevAddr = STSAFEA_DEVICE_ADDRESS;
+    }
+
+    return STSAFEA_BUS_OK;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_INTERFACE_LINUX_H_
+#define CATIE_SIXTRON_STSAFEA_INTERFACE_LINUX_H_
+
+#include <stdint.h>
+
+#include <linux/i2c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Time between two readings of a response the device is still processing */
+#ifndef STSAFEA_LINUX_I2C_POLL_INTERVAL_US
+#define STSAFEA_LINUX_I2C_POLL_INTERVAL_US 100U
+#endif
+
+/* Time a response reading is retried before reporting the NACK to the middleware, which then
+ * waits STSAFEA_I2C_RESPONSE_POLLING_STEP ms before the next reading */
+#ifndef STSAFEA_LINUX_I2C_POLL_WINDOW_US
+#define STSAFEA_LINUX_I2C_POLL_WINDOW_US 1000U
+#endif
+
+/*
+ * Bus context of a device on a Linux i2c-dev adapter, given as pBusCtx to StSafeA_InitDevice.
+ *
+ * Every bus phase is a single I2C_RDWR transaction carrying the device address, so devices at
+ * different addresses can share the same file descriptor. The transfer function defaults to the
+ * I2C_RDWR ioctl and can be replaced by an in-process fake to run the middleware without an
+ * adapter. It returns 0 on success, -1 with errno set otherwise, like ioctl.
+ */
+typedef struct {
+    int fd;
+    int (*transfer)(void *transfer_ctx, struct i2c_msg *msgs, uint32_t msg_number);
+    void *transfer_ctx;
+} stsafea_linux_bus_t;
+
+/* Open /dev/i2c-N. Returns 0 on success, -1 with errno set otherwise. */
+int stsafea_linux_bus_open(stsafea_linux_bus_t *bus, const char *path);
+
+void stsafea_linux_bus_close(stsafea_linux_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_INTERFACE_LINUX_H_
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafea_replay.h"
+#include "stsafea_service.h"
+
+#include <string.h>
+
+/* Command header and CRC */
+#define COMMAND_MIN_LENGTH 3U
+
+/* Response header: status and length */
+#define RESPONSE_HEADER_LENGTH 3U
+
+static uint16_t response_frame_length(const uint8_t *data, uint16_t length)
+{
+    uint32_t frame_length;
+
+    if (length < RESPONSE_HEADER_LENGTH) {
+        return length;
+    }
+    frame_length = RESPONSE_HEADER_LENGTH + (((uint32_t)data[1] << 8) | data[2]);
+
+    return (frame_length < length) ? (uint16_t)frame_length : length;
+}
+
+int32_t stsafea_replay_load(const uint8_t *trace,
+        uint32_t length,
+        stsafea_replay_exchange_t *exchanges,
+        uint32_t max_number)
+{
+    stsafea_capture_record_t record;
+    stsafea_replay_exchange_t *exchange = NULL;
+    uint32_t offset = 0;
+    uint32_t number = 0;
+    uint32_t now_us = 0;
+    uint32_t start_us = 0;
+    uint16_t send_nacks = 0;
+    int ret;
+
+    while ((ret = stsafea_capture_next(trace, length, &offset, &record)) == 1) {
+        now_us += record.delta_us;
+
+        switch (record.type) {
+            case STSAFEA_CAPTURE_SEND:
+                if (record.status == STSAFEA_BUS_NACK) {
+                    send_nacks++;
+                } else if (record.status == STSAFEA_BUS_OK) {
+                    if (number >= max_number) {
+                        return -1;
+                    }
+                    exchange = &exchanges[number++];
+                    memset(exchange, 0, sizeof(*exchange));
+                    exchange->command = record.data;
+                    exchange->command_length = record.data_length;
+                    exchange->send_nacks = send_nacks;
+                    send_nacks = 0;
+                    start_us = now_us;
+                }
+                break;
+            case STSAFEA_CAPTURE_RECV:
+            case STSAFEA_CAPTURE_RECV_FRAME:
+                if (exchange == NULL) {
+                    break;
+                }
+                if ((record.status == STSAFEA_BUS_NACK) && (exchange->response == NULL)) {
+                    exchange->recv_nacks++;
+                } else if (record.status == STSAFEA_BUS_OK) {
+                    uint16_t frame_length = response_frame_length(record.data, record.data_length);
+                    if (exchange->response == NULL) {
+                        exchange->latency_us = now_us - start_us;
+                    }
+                    if (frame_length > exchange->response_length) {
+                        exchange->response = record.data;
+                        exchange->response_length = frame_length;
+                    }
+                }
+                break;
+            case STSAFEA_CAPTURE_DELAY:
+                if ((exchange != NULL) && (exchange->response == NULL)) {
+                    exchange->delay_ms += record.length;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return (ret < 0) ? -1 : (int32_t)number;
+}
+
+static int32_t replay_send(void *pBusCtx, uint16_t address, uint8_t *pData, uint16_t Length)
+{
+    stsafea_replay_t *replay = (stsafea_replay_t *)pBusCtx;
+    const stsafea_replay_exchange_t *exchange;
+    (void)address;
+
+    if (replay->current >= replay->exchange_number) {
+        return STSAFEA_BUS_ERR;
+    }
+    if (replay->send_nacks_left != 0U) {
+        replay->send_nacks_left--;
+        return STSAFEA_BUS_NACK;
+    }
+
+    exchange = &replay->exchanges[replay->current];
+    if ((Length != exchange->command_length) || (memcmp(pData, exchange->command, Length) != 0)) {
+        replay->mismatches++;
+    }
+
+    return STSAFEA_BUS_OK;
+}
+
+static int32_t replay_recv(void *pBusCtx, uint16_t address, uint8_t *pData, uint16_t Length)
+{
+    stsafea_replay_t *replay = (stsafea_replay_t *)pBusCtx;
+    const stsafea_replay_exchange_t *exchange;
+    (void)address;
+
+    if (replay->current >= replay->exchange_number) {
+        return STSAFEA_BUS_ERR;
+    }
+    if (replay->recv_nacks_left != 0U) {
+        replay->recv_nacks_left--;
+        return STSAFEA_BUS_NACK;
+    }
+
+    exchange = &replay->exchanges[replay->current];
+    if (exchange->response == NULL) {
+        return STSAFEA_BUS_ERR;
+    }
+
+    /* Beyond the frame, the bus reads 0xFF */
+    memset(pData, 0xFF, Length);
+    memcpy(pData,
+            exchange->response,
+            (Length < exchange->response_length) ? Length : exchange->response_length);
+
+    return STSAFEA_BUS_OK;
+}
+
+static void replay_delay(uint32_t msDelay)
+{
+    (void)msDelay;
+}
+
+void stsafea_replay_attach(stsafea_replay_t *replay,
+        StSafeA_Handle_t *handle,
+        const stsafea_replay_exchange_t *exchanges,
+        uint32_t exchange_number)
+{
+    STSAFEA_HW_t *hw = &handle->HwCtx;
+
+    replay->exchanges = exchanges;
+    replay->exchange_number = exchange_number;
+    replay->current = 0;
+    replay->send_nacks_left = 0;
+    replay->recv_nacks_left = 0;
+    replay->mismatches = 0;
+
+    hw->BusSend = replay_send;
+    hw->BusRecv = replay_recv;
+    hw->BusRecvFrame = NULL;
+    hw->TimeDelay = replay_delay;
+    hw->BusDelay = NULL;
+    hw->pBusCtx = replay;
+}
+
+StSafeA_ResponseCode_t stsafea_replay_next(stsafea_replay_t *replay, StSafeA_Handle_t *handle)
+{
+    const stsafea_replay_exchange_t *exchange;
+    StSafeA_TLVBuffer_t command;
+    StSafeA_TLVBuffer_t response;
+    uint16_t response_data_length = 0;
+    StSafeA_ResponseCode_t status;
+
+    if (replay->current >= replay->exchange_number) {
+        return STSAFEA_INVALID_PARAMETER;
+    }
+    exchange = &replay->exchanges[replay->current];
+    if (exchange->command_length < COMMAND_MIN_LENGTH) {
+        replay->current++;
+        replay->mismatches++;
+        return STSAFEA_INVALID_PARAMETER;
+    }
+
+    /* The whole frame but the CRC: MACs included and the MAC bits kept in the header */
+    command.Header = exchange->command[0];
+    command.LV.Length = exchange->command_length - COMMAND_MIN_LENGTH;
+    command.LV.Data = (uint8_t *)&exchange->command[STSAFEA_HEADER_LENGTH];
+    if ((exchange->response != NULL)
+            && (exchange->response_length >= RESPONSE_HEADER_LENGTH + STSAFEA_CRC_LENGTH)) {
+        response_data_length = (uint16_t)(exchange->response_length - RESPONSE_HEADER_LENGTH
+                - STSAFEA_CRC_LENGTH);
+    }
+    response.LV.Data = replay->response;
+
+    replay->send_nacks_left = exchange->send_nacks;
+    replay->recv_nacks_left = exchange->recv_nacks;
+    status = StSafeA_RawCommand(handle,
+            &command,
+            response_data_length,
+            &response,
+            exchange->delay_ms,
+            STSAFEA_MAC_NONE);
+    replay->current++;
+
+    return status;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_REPLAY_H_
+#define CATIE_SIXTRON_STSAFEA_REPLAY_H_
+
+#include <stdint.h>
+
+#include "stsafea_capture.h"
+#include "stsafea_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A command of a capture and what the device answered */
+typedef struct {
+    const uint8_t *command; /* Frame written, into the trace */
+    uint16_t command_length;
+    const uint8_t *response; /* Longest response read, into the trace, NULL if none */
+    uint16_t response_length;
+    uint16_t send_nacks; /* Writes NACKed before the command was accepted */
+    uint16_t recv_nacks; /* Reads NACKed before the response was available */
+    uint32_t delay_ms; /* Delays between the command and the response */
+    uint32_t latency_us; /* From the command to the response */
+} stsafea_replay_exchange_t;
+
+typedef struct {
+    const stsafea_replay_exchange_t *exchanges;
+    uint32_t exchange_number;
+
+    /* Replay state */
+    uint32_t current;
+    uint16_t send_nacks_left;
+    uint16_t recv_nacks_left;
+    uint32_t mismatches; /* Commands differing from those of the capture */
+    uint8_t response[STSAFEA_BUFFER_DATA_CONTENT_SIZE];
+} stsafea_replay_t;
+
+/*
+ * Split a capture into exchanges, returns their number or -1 if the trace is malformed or has
+ * more than max_number exchanges. The exchanges point into trace, which must be kept.
+ */
+int32_t stsafea_replay_load(const uint8_t *trace,
+        uint32_t length,
+        stsafea_replay_exchange_t *exchanges,
+        uint32_t max_number);
+
+/*
+ * Make an initialized device answer with the exchanges, at full speed: delays return at once and
+ * the NACKs of the capture are replayed without waiting.
+ */
+void stsafea_replay_attach(stsafea_replay_t *replay,
+        StSafeA_Handle_t *handle,
+        const stsafea_replay_exchange_t *exchanges,
+        uint32_t exchange_number);
+
+/*
+ * Send the next command of the capture through StSafeA_RawCommand, returns its response code,
+ * STSAFEA_INVALID_PARAMETER once all the exchanges are replayed. StSafeA_RawCommand does not know
+ * the commands, so MACs are sent and received as data.
+ */
+StSafeA_ResponseCode_t stsafea_replay_next(stsafea_replay_t *replay, StSafeA_Handle_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_REPLAY_H_
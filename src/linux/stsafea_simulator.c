@@ -0,0 +1,1037 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "stsafea_simulator.h"
+#include "stsafea_core.h"
+#include "stsafea_crc16x25.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#define SIM_DEFAULT_ADDRESS 0x20
+#define SIM_ONE_WAY_COUNTER 500000U
+#define SIM_KEY_SLOT_EPHEMERAL 2U
+#define SIM_PASSWORD_TRIES 3U
+#define SIM_ENVELOPE_TAG_LENGTH 8U
+#define SIM_HOST_CMAC_COUNTER_MAX 0xFFFFFFU
+#define SIM_HOST_CMAC_TAG 0xC3U
+
+/* Offset of the data in a response frame, after the status and the length */
+#define SIM_RESPONSE_DATA 3U
+
+static const uint16_t zone_sizes[STSAFEA_SIM_ZONE_NUMBER] = {
+    1000, 700, 600, 600, 1696, 64, 1000, 64
+};
+
+/* Typical processing times of the STSAFE-A110, in us */
+static const struct {
+    uint8_t code;
+    uint32_t busy_us;
+} default_busy_times[] = {
+    { STSAFEA_CMD_ECHO, 500 },
+    { STSAFEA_CMD_RESET, 10000 },
+    { STSAFEA_CMD_GENERATE_RANDOM, 3000 },
+    { STSAFEA_CMD_DECREMENT, 7000 },
+    { STSAFEA_CMD_READ, 600 },
+    { STSAFEA_CMD_UPDATE, 7000 },
+    { STSAFEA_CMD_DELETE_KEY, 5000 },
+    { STSAFEA_CMD_HIBERNATE, 1000 },
+    { STSAFEA_CMD_WRAP_LOCAL_ENVELOPE, 6000 },
+    { STSAFEA_CMD_UNWRAP_LOCAL_ENVELOPE, 6000 },
+    { STSAFEA_CMD_PUT_ATTRIBUTE, 7000 },
+    { STSAFEA_CMD_GENERATE_KEY, 90000 },
+    { STSAFEA_CMD_QUERY, 500 },
+    { STSAFEA_CMD_GENERATE_SIGNATURE, 50000 },
+    { STSAFEA_CMD_VERIFY_SIGNATURE, 85000 },
+    { STSAFEA_CMD_ESTABLISH_KEY, 140000 },
+    { STSAFEA_CMD_VERIFY_PASSWORD, 7000 },
+};
+
+/* Command being processed */
+typedef struct {
+    uint8_t header;
+    const uint8_t *data;
+    uint16_t length;
+    uint8_t *response; /* Response data */
+    uint16_t response_length;
+} sim_command_t;
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000U) + ((uint64_t)now.tv_nsec / 1000U);
+}
+
+static uint64_t random_next(stsafea_sim_t *sim)
+{
+    /* xorshift64* */
+    sim->random ^= sim->random >> 12;
+    sim->random ^= sim->random << 25;
+    sim->random ^= sim->random >> 27;
+
+    return sim->random * 0x2545F4914F6CDD1DULL;
+}
+
+static void random_fill(stsafea_sim_t *sim, uint8_t *out, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++) {
+        out[i] = (uint8_t)(random_next(sim) >> 56);
+    }
+}
+
+/* FNV-1a, the keyed hash behind the simulated cryptography */
+static uint64_t hash(uint64_t h, const uint8_t *data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++) {
+        h = (h ^ data[i]) * 0x100000001B3ULL;
+    }
+
+    return h;
+}
+
+/* Stretch a hash of (a, b) to length bytes with splitmix64 */
+static void mix(const uint8_t *a,
+        uint16_t a_length,
+        const uint8_t *b,
+        uint16_t b_length,
+        uint8_t *out,
+        uint16_t length)
+{
+    uint64_t h = hash(hash(0xCBF29CE484222325ULL, a, a_length), b, b_length);
+
+    for (uint16_t i = 0; i < length; i++) {
+        uint64_t z;
+        if ((i % 8U) == 0U) {
+            h += 0x9E3779B97F4A7C15ULL;
+        }
+        z = h;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        out[i] = (uint8_t)(z >> (8U * (i % 8U)));
+    }
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+static void put_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+static void put_u32(uint8_t *p, uint32_t value)
+{
+    put_u16(p, (uint16_t)(value >> 16));
+    put_u16(&p[2], (uint16_t)value);
+}
+
+/* Frame CRC, as transmitted: inverted CRC16-X25 register, most significant byte first */
+static uint16_t frame_crc(uint8_t header, const uint8_t *data, uint16_t length)
+{
+    return (uint16_t)(stsafea_crc16x25_compute(header, data, length) ^ 0xFFFFU);
+}
+
+/* Coordinate length of a curve object identifier, 0 if the curve is not supported */
+static uint8_t curve_length(const uint8_t *oid, uint16_t oid_length)
+{
+    static const struct {
+        const int8_t *oid;
+        uint16_t length;
+        uint8_t coordinate;
+    } curves[] = {
+        { STSAFEA_ECC_CURVE_OID_NIST_P_256, STSAFEA_ECC_CURVE_OID_NIST_P_256_LEN, 32 },
+        { STSAFEA_ECC_CURVE_OID_BRAINPOOL_P_256, STSAFEA_ECC_CURVE_OID_BRAINPOOL_P_256_LEN, 32 },
+        { STSAFEA_ECC_CURVE_OID_NIST_P_384, STSAFEA_ECC_CURVE_OID_NIST_P_384_LEN, 48 },
+        { STSAFEA_ECC_CURVE_OID_BRAINPOOL_P_384, STSAFEA_ECC_CURVE_OID_BRAINPOOL_P_384_LEN, 48 },
+    };
+
+    for (uint32_t i = 0; i < sizeof(curves) / sizeof(curves[0]); i++) {
+        if ((oid_length == curves[i].length) && (memcmp(oid, curves[i].oid, oid_length) == 0)) {
+            return curves[i].coordinate;
+        }
+    }
+
+    return 0;
+}
+
+static void generate_key(stsafea_sim_t *sim, stsafea_sim_key_t *key, uint8_t length)
+{
+    uint8_t point[2U * STSAFEA_SIM_KEY_MAX_LENGTH];
+
+    key->present = 1;
+    key->length = length;
+    random_fill(sim, key->secret, length);
+    mix((const uint8_t *)"public", 6, key->secret, length, point, 2U * length);
+    memcpy(key->x, point, length);
+    memcpy(key->y, &point[length], length);
+}
+
+/* Signature of a digest by the key of public point (x, y), r and s following each other */
+static void sign(const uint8_t *xy,
+        uint16_t xy_length,
+        const uint8_t *digest,
+        uint16_t digest_length,
+        uint8_t *rs,
+        uint16_t length)
+{
+    mix(xy, xy_length, digest, digest_length, rs, 2U * length);
+}
+
+/* Read a length-value field, returns the value length or -1 if it overflows the command */
+static int32_t get_lv(const sim_command_t *cmd, uint16_t *offset, const uint8_t **value)
+{
+    uint16_t length;
+
+    if ((uint32_t)*offset + 2U > cmd->length) {
+        return -1;
+    }
+    length = get_u16(&cmd->data[*offset]);
+    if ((uint32_t)*offset + 2U + length > cmd->length) {
+        return -1;
+    }
+    *value = &cmd->data[*offset + 2U];
+    *offset += 2U + length;
+
+    return length;
+}
+
+static void respond_lv(sim_command_t *cmd, const uint8_t *value, uint16_t length)
+{
+    put_u16(&cmd->response[cmd->response_length], length);
+    memcpy(&cmd->response[cmd->response_length + 2U], value, length);
+    cmd->response_length += 2U + length;
+}
+
+/* Access conditions requiring a host C-MAC are satisfied by any command with the C-MAC bit */
+static StSafeA_ResponseCode_t check_access(const sim_command_t *cmd, uint8_t ac)
+{
+    if (ac == STSAFEA_AC_ALWAYS) {
+        return STSAFEA_OK;
+    }
+    if ((ac <= STSAFEA_AC_MAC) && ((cmd->header & STSAFEA_CMD_HEADER_CMACEN) != 0U)) {
+        return STSAFEA_OK;
+    }
+
+    return STSAFEA_UNSATISFIED_ACCESS_CONDITION;
+}
+
+/* Change an access condition following bits 4 (change), 3 (new change right) and 2..0 (new AC) */
+static StSafeA_ResponseCode_t change_access(uint8_t request, uint8_t *ac, uint8_t *change_right)
+{
+    uint8_t new_ac = request & STSAFEA_AC_MSK;
+
+    if ((request & 0x10U) == 0U) {
+        return STSAFEA_OK;
+    }
+    if ((*change_right == 0U) || (new_ac < *ac)) {
+        return STSAFEA_UNSATISFIED_ACCESS_CONDITION;
+    }
+    *ac = new_ac;
+    *change_right = (request >> 3) & 0x01U;
+
+    return STSAFEA_OK;
+}
+
+/* Zone of a Read, Update or Decrement command, with the range it accesses */
+static StSafeA_ResponseCode_t get_zone(stsafea_sim_t *sim,
+        uint8_t index,
+        uint16_t offset,
+        uint32_t length,
+        stsafea_sim_zone_t **zone)
+{
+    if (index >= STSAFEA_SIM_ZONE_NUMBER) {
+        return STSAFEA_ENTRY_NOT_FOUND;
+    }
+    *zone = &sim->zone[index];
+    if ((uint32_t)offset + length > (*zone)->size) {
+        return STSAFEA_BOUNDARY_EXCEEDED;
+    }
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_read(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    stsafea_sim_zone_t *zone;
+    StSafeA_ResponseCode_t status;
+    uint16_t length;
+
+    if (cmd->length != 6U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    length = get_u16(&cmd->data[4]);
+    status = get_zone(sim, cmd->data[1], get_u16(&cmd->data[2]), length, &zone);
+    if (status == STSAFEA_OK) {
+        status = check_access(cmd, zone->read_ac);
+    }
+    if (status == STSAFEA_OK) {
+        status = change_access(cmd->data[0], &zone->read_ac, &zone->read_ac_change_right);
+    }
+    if (status == STSAFEA_OK) {
+        memcpy(cmd->response, &sim->zone_memory[zone->offset + get_u16(&cmd->data[2])], length);
+        cmd->response_length = length;
+    }
+
+    return status;
+}
+
+static StSafeA_ResponseCode_t cmd_update(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    stsafea_sim_zone_t *zone;
+    StSafeA_ResponseCode_t status;
+    uint16_t length;
+
+    if (cmd->length < 4U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    length = cmd->length - 4U;
+    if (((cmd->data[0] & STSAFEA_CMD_UPDATE_HEADER_ATOMEN) != 0U)
+            && (length > STSAFEA_ATOMICITY_BUFFER_SIZE)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    status = get_zone(sim, cmd->data[1], get_u16(&cmd->data[2]), length, &zone);
+    if (status == STSAFEA_OK) {
+        status = check_access(cmd, zone->update_ac);
+    }
+    if (status == STSAFEA_OK) {
+        status = change_access(cmd->data[0], &zone->update_ac, &zone->update_ac_change_right);
+    }
+    if (status == STSAFEA_OK) {
+        memcpy(&sim->zone_memory[zone->offset + get_u16(&cmd->data[2])], &cmd->data[4], length);
+    }
+
+    return status;
+}
+
+static StSafeA_ResponseCode_t cmd_decrement(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    stsafea_sim_zone_t *zone;
+    StSafeA_ResponseCode_t status;
+    uint32_t amount;
+    uint16_t length;
+
+    if (cmd->length < 8U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    amount = ((uint32_t)get_u16(&cmd->data[4]) << 16) | get_u16(&cmd->data[6]);
+    length = cmd->length - 8U;
+    status = get_zone(sim, cmd->data[1], get_u16(&cmd->data[2]), length, &zone);
+    if ((status == STSAFEA_OK) && (zone->counter == 0U)) {
+        status = STSAFEA_INCORRECT_ZONE_TYPE;
+    }
+    if (status == STSAFEA_OK) {
+        status = check_access(cmd, zone->update_ac);
+    }
+    if ((status == STSAFEA_OK) && (amount > zone->one_way_counter)) {
+        status = STSAFEA_COUNTER_LIMIT_EXCEEDED;
+    }
+    if (status == STSAFEA_OK) {
+        status = change_access(cmd->data[0], &zone->update_ac, &zone->update_ac_change_right);
+    }
+    if (status == STSAFEA_OK) {
+        zone->one_way_counter -= amount;
+        memcpy(&sim->zone_memory[zone->offset + get_u16(&cmd->data[2])], &cmd->data[8], length);
+        put_u32(cmd->response, zone->one_way_counter);
+        cmd->response_length = 4U;
+    }
+
+    return status;
+}
+
+static StSafeA_ResponseCode_t query_product_data(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    /* Tag, length and value of each field, in the order parsed by StSafeA_ProductDataQuery */
+    static const uint8_t product_data[] = {
+        0x01, 3, 0x02, 0x09, 0x0A, /* Mask identification */
+        0x02, 9, 0x02, 0x09, 0x0A, 0x53, 0x49, 0x4D, 0x00, 0x00, 0x01, /* ST number */
+        0x03, 2, 0x01, 0xFB, /* Input/output buffer size: 507 */
+        0x04, 2, 0x00, 0x40, /* Atomicity buffer size: 64 */
+        0x05, 2, 0x16, 0x5C, /* Non-volatile memory size: 5724 */
+        0x06, 2, 0x00, 0x00, /* Test date */
+        0x07, 1, 0x01, /* Internal product version */
+        0x08, 2, 0x00, 0x00, /* Module date */
+        0x09, 3, 0x00, 0x00, 0x00, /* Firmware delivery traceability */
+        0x0A, 3, 0x00, 0x00, 0x00, /* Blackbox delivery traceability */
+        0x0B, 3, 0x00, 0x00, 0x00, /* Perso ID */
+        0x0C, 3, 0x00, 0x00, 0x00, /* Perso generation batch ID */
+        0x0D, 3, 0x00, 0x00, 0x00, /* Perso date */
+    };
+
+    (void)sim;
+    memcpy(cmd->response, product_data, sizeof(product_data));
+    cmd->response_length = sizeof(product_data);
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t query_data_partition(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    uint8_t *p = &cmd->response[1];
+
+    cmd->response[0] = STSAFEA_SIM_ZONE_NUMBER;
+    for (uint8_t i = 0; i < STSAFEA_SIM_ZONE_NUMBER; i++) {
+        const stsafea_sim_zone_t *zone = &sim->zone[i];
+        *p++ = i;
+        *p++ = zone->counter;
+        *p++ = (uint8_t)((zone->read_ac_change_right << 7) | (zone->read_ac << 4)
+                | (zone->update_ac_change_right << 3) | zone->update_ac);
+        put_u16(p, zone->size);
+        p += 2;
+        if (zone->counter != 0U) {
+            put_u32(p, zone->one_way_counter);
+            p += 4;
+        }
+    }
+    cmd->response_length = (uint16_t)(p - cmd->response);
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t query_local_envelope_key_table(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    uint8_t *p = &cmd->response[1];
+
+    cmd->response[0] = STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER;
+    for (uint8_t i = 0; i < STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER; i++) {
+        *p++ = i;
+        *p++ = (sim->envelope_key_length[i] != 0U) ? 1U : 0U;
+        if (sim->envelope_key_length[i] != 0U) {
+            *p++ = sim->envelope_key_length[i];
+        }
+    }
+    cmd->response_length = (uint16_t)(p - cmd->response);
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_query(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    if (cmd->length != 1U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+
+    switch (cmd->data[0]) {
+        case STSAFEA_TAG_PRODUCT_DATA:
+            return query_product_data(sim, cmd);
+        case STSAFEA_TAG_DATA_PARTITION_CONFIGURATION:
+            return query_data_partition(sim, cmd);
+        case STSAFEA_TAG_LOCAL_ENVELOPE_KEY_TABLE:
+            return query_local_envelope_key_table(sim, cmd);
+        case STSAFEA_TAG_LIFE_CYCLE_STATE:
+            cmd->response[0] = STSTAFEA_LIFECYCLE_STATE_OPERATIONAL;
+            cmd->response_length = 1U;
+            return STSAFEA_OK;
+        case STSAFEA_TAG_I2C_PARAMETER:
+            memcpy(cmd->response, sim->i2c_parameter, sizeof(sim->i2c_parameter));
+            cmd->response_length = sizeof(sim->i2c_parameter);
+            return STSAFEA_OK;
+        case STSAFEA_TAG_HOST_KEY_SLOT:
+            cmd->response[0] = sim->host_key_present;
+            cmd->response[1] = (uint8_t)(sim->host_cmac_counter >> 16);
+            put_u16(&cmd->response[2], (uint16_t)sim->host_cmac_counter);
+            cmd->response_length = 4U;
+            return STSAFEA_OK;
+        case STSAFEA_TAG_COMMAND_AUTHORIZATION_CONFIGURATION:
+            /* No change right, no command authorization record */
+            cmd->response[0] = 0U;
+            cmd->response[1] = 0U;
+            cmd->response_length = 2U;
+            return STSAFEA_OK;
+        default:
+            return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+}
+
+static StSafeA_ResponseCode_t cmd_put_attribute(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    if (cmd->length < 1U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+
+    switch (cmd->data[0]) {
+        case STSAFEA_TAG_HOST_KEY_SLOT:
+            if (cmd->length != 1U + (2U * STSAFEA_HOST_KEY_LENGTH)) {
+                return STSAFEA_INCONSISTENT_COMMAND_DATA;
+            }
+            sim->host_key_present = 1U;
+            sim->host_cmac_counter = 0U;
+            return STSAFEA_OK;
+        case STSAFEA_TAG_I2C_PARAMETER:
+            if (cmd->length != 1U + sizeof(sim->i2c_parameter_next)) {
+                return STSAFEA_INCONSISTENT_COMMAND_DATA;
+            }
+            if ((sim->i2c_parameter_next[1] & STSAFEA_I2C_LOCK_MSK) != 0U) {
+                return STSAFEA_UNSATISFIED_ACCESS_CONDITION;
+            }
+            memcpy(sim->i2c_parameter_next, &cmd->data[1], sizeof(sim->i2c_parameter_next));
+            return STSAFEA_OK;
+        case STSAFEA_TAG_PASSWORD_SLOT:
+            if (cmd->length < 1U + sizeof(sim->password)) {
+                return STSAFEA_INCONSISTENT_COMMAND_DATA;
+            }
+            memcpy(sim->password, &cmd->data[1], sizeof(sim->password));
+            sim->password_present = 1U;
+            sim->password_tries = SIM_PASSWORD_TRIES;
+            return STSAFEA_OK;
+        default:
+            return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+}
+
+static StSafeA_ResponseCode_t cmd_delete_key(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    if ((cmd->length != 1U) || (cmd->data[0] != STSAFEA_TAG_PASSWORD_SLOT)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    sim->password_present = 0U;
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_verify_password(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    if (cmd->length != sizeof(sim->password)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    if (sim->password_present == 0U) {
+        return STSAFEA_KEY_NOT_FOUND;
+    }
+    if (sim->password_tries == 0U) {
+        return STSAFEA_PASSWORD_BLOCKED;
+    }
+
+    if (memcmp(cmd->data, sim->password, sizeof(sim->password)) == 0) {
+        sim->password_tries = SIM_PASSWORD_TRIES;
+        cmd->response[0] = 1U;
+    } else {
+        sim->password_tries--;
+        cmd->response[0] = 0U;
+    }
+    cmd->response[1] = sim->password_tries;
+    cmd->response_length = 2U;
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t generate_envelope_key(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    uint8_t slot = cmd->data[1];
+    uint8_t length;
+
+    if ((cmd->length < 3U) || (slot >= STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    if (cmd->data[2] == STSAFEA_KEY_TYPE_AES_128) {
+        length = 16U;
+    } else if (cmd->data[2] == STSAFEA_KEY_TYPE_AES_256) {
+        length = 32U;
+    } else {
+        return STSAFEA_WRONG_KEY_TYPE;
+    }
+
+    /* The seed, if any, is mixed with the random number */
+    random_fill(sim, sim->envelope_key[slot], length);
+    mix(sim->envelope_key[slot],
+            length,
+            &cmd->data[3],
+            cmd->length - 3U,
+            sim->envelope_key[slot],
+            length);
+    sim->envelope_key_length[slot] = length;
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_generate_key(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    stsafea_sim_key_t *key;
+    uint8_t slot;
+    uint8_t length;
+
+    if ((cmd->length >= 3U) && (cmd->data[0] == STSAFEA_TAG_LOCAL_ENVELOPE_KEY_TABLE)) {
+        return generate_envelope_key(sim, cmd);
+    }
+    if ((cmd->length < 8U) || (cmd->data[0] != STSAFEA_TAG_PRIVATE_KEY_SLOT)
+            || ((uint32_t)8U + get_u16(&cmd->data[6]) != cmd->length)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    slot = (cmd->data[1] == STSAFEA_KEY_SLOT_EPHEMERAL) ? SIM_KEY_SLOT_EPHEMERAL : cmd->data[1];
+    if (slot >= STSAFEA_SIM_KEY_SLOT_NUMBER) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    length = curve_length(&cmd->data[8], get_u16(&cmd->data[6]));
+    if (length == 0U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+
+    key = &sim->key[slot];
+    generate_key(sim, key, length);
+    cmd->response[0] = STSAFEA_POINT_REPRESENTATION_ID;
+    cmd->response_length = 1U;
+    respond_lv(cmd, key->x, length);
+    respond_lv(cmd, key->y, length);
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_generate_signature(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    uint8_t xy[2U * STSAFEA_SIM_KEY_MAX_LENGTH];
+    uint8_t rs[2U * STSAFEA_SIM_KEY_MAX_LENGTH];
+    stsafea_sim_key_t *key;
+    uint16_t digest_length;
+
+    if (cmd->length < 3U) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    digest_length = get_u16(&cmd->data[1]);
+    if (((digest_length != STSAFEA_SHA_256_LENGTH) && (digest_length != STSAFEA_SHA_384_LENGTH))
+            || (3U + digest_length != cmd->length)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    if (cmd->data[0] >= SIM_KEY_SLOT_EPHEMERAL) {
+        return STSAFEA_WRONG_KEY_USAGE;
+    }
+    key = &sim->key[cmd->data[0]];
+    if (key->present == 0U) {
+        return STSAFEA_KEY_NOT_FOUND;
+    }
+
+    memcpy(xy, key->x, key->length);
+    memcpy(&xy[key->length], key->y, key->length);
+    sign(xy, 2U * key->length, &cmd->data[3], digest_length, rs, key->length);
+    respond_lv(cmd, rs, key->length);
+    respond_lv(cmd, &rs[key->length], key->length);
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_verify_signature(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    uint8_t xy[2U * STSAFEA_SIM_KEY_MAX_LENGTH];
+    uint8_t rs[2U * STSAFEA_SIM_KEY_MAX_LENGTH];
+    const uint8_t *x = NULL, *y = NULL, *r = NULL, *s = NULL, *digest = NULL;
+    int32_t x_length, y_length, r_length, s_length, digest_length;
+    uint16_t offset;
+    uint8_t length;
+
+    (void)sim;
+    if ((cmd->length < 3U) || (cmd->data[0] != 0U)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    offset = 3U + get_u16(&cmd->data[1]);
+    if (offset >= cmd->length) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    length = curve_length(&cmd->data[3], get_u16(&cmd->data[1]));
+    if ((length == 0U) || (cmd->data[offset] != STSAFEA_POINT_REPRESENTATION_ID)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    offset++;
+    x_length = get_lv(cmd, &offset, &x);
+    y_length = get_lv(cmd, &offset, &y);
+    r_length = get_lv(cmd, &offset, &r);
+    s_length = get_lv(cmd, &offset, &s);
+    digest_length = get_lv(cmd, &offset, &digest);
+    if ((x_length < 0) || (y_length < 0) || (r_length < 0) || (s_length < 0) || (digest_length < 0)
+            || (offset != cmd->length)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    if ((x_length != length) || (y_length != length)) {
+        return STSAFEA_INVALID_PUBLIC_KEY;
+    }
+
+    memcpy(xy, x, length);
+    memcpy(&xy[length], y, length);
+    sign(xy, 2U * length, digest, (uint16_t)digest_length, rs, length);
+    cmd->response[0] = ((r_length == length) && (s_length == length) && (memcmp(rs, r, length) == 0)
+                               && (memcmp(&rs[length], s, length) == 0))
+            ? 1U
+            : 0U;
+    cmd->response_length = 1U;
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t cmd_establish_key(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    const uint8_t *x = NULL, *y = NULL;
+    int32_t x_length, y_length;
+    stsafea_sim_key_t *key;
+    uint8_t secret[STSAFEA_SIM_KEY_MAX_LENGTH];
+    uint16_t offset = 2U;
+    uint8_t slot;
+
+    if ((cmd->length < 2U) || (cmd->data[1] != STSAFEA_POINT_REPRESENTATION_ID)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    x_length = get_lv(cmd, &offset, &x);
+    y_length = get_lv(cmd, &offset, &y);
+    if ((x_length < 0) || (y_length < 0) || (offset != cmd->length)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    slot = (cmd->data[0] == STSAFEA_KEY_SLOT_EPHEMERAL) ? SIM_KEY_SLOT_EPHEMERAL : cmd->data[0];
+    if (slot >= STSAFEA_SIM_KEY_SLOT_NUMBER) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    key = &sim->key[slot];
+    if (key->present == 0U) {
+        return STSAFEA_KEY_NOT_FOUND;
+    }
+    if ((x_length != key->length) || (y_length != key->length)) {
+        return STSAFEA_INVALID_PUBLIC_KEY;
+    }
+
+    /* Symmetric in the two public keys, so that both sides get the same secret */
+    if (memcmp(key->x, x, key->length) < 0) {
+        mix(key->x, key->length, x, key->length, secret, key->length);
+    } else {
+        mix(x, key->length, key->x, key->length, secret, key->length);
+    }
+    respond_lv(cmd, secret, key->length);
+
+    /* The ephemeral key is used once */
+    if (slot == SIM_KEY_SLOT_EPHEMERAL) {
+        key->present = 0U;
+    }
+
+    return STSAFEA_OK;
+}
+
+/* An envelope is a tag of the data, then the data masked with a stream derived from the tag */
+static StSafeA_ResponseCode_t cmd_local_envelope(
+        stsafea_sim_t *sim, sim_command_t *cmd, uint8_t wrap)
+{
+    uint8_t stream[STSAFEA_SIM_FRAME_MAX_LENGTH];
+    const uint8_t *key;
+    uint8_t key_length;
+    const uint8_t *in = &cmd->data[1];
+    uint16_t length;
+
+    if ((cmd->length < 1U) || (cmd->data[0] >= STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER)) {
+        return STSAFEA_INCONSISTENT_COMMAND_DATA;
+    }
+    key = sim->envelope_key[cmd->data[0]];
+    key_length = sim->envelope_key_length[cmd->data[0]];
+    if (key_length == 0U) {
+        return STSAFEA_KEY_NOT_FOUND;
+    }
+    length = cmd->length - 1U;
+
+    if (wrap != 0U) {
+        if ((length == 0U) || ((length % 8U) != 0U)) {
+            return STSAFEA_INCONSISTENT_COMMAND_DATA;
+        }
+        mix(key, key_length, in, length, cmd->response, SIM_ENVELOPE_TAG_LENGTH);
+        mix(key, key_length, cmd->response, SIM_ENVELOPE_TAG_LENGTH, stream, length);
+        for (uint16_t i = 0; i < length; i++) {
+            cmd->response[SIM_ENVELOPE_TAG_LENGTH + i] = in[i] ^ stream[i];
+        }
+        cmd->response_length = SIM_ENVELOPE_TAG_LENGTH + length;
+    } else {
+        uint8_t tag[SIM_ENVELOPE_TAG_LENGTH];
+        if ((length <= SIM_ENVELOPE_TAG_LENGTH) || ((length % 8U) != 0U)) {
+            return STSAFEA_INCONSISTENT_COMMAND_DATA;
+        }
+        length -= SIM_ENVELOPE_TAG_LENGTH;
+        mix(key, key_length, in, SIM_ENVELOPE_TAG_LENGTH, stream, length);
+        for (uint16_t i = 0; i < length; i++) {
+            cmd->response[i] = in[SIM_ENVELOPE_TAG_LENGTH + i] ^ stream[i];
+        }
+        mix(key, key_length, cmd->response, length, tag, SIM_ENVELOPE_TAG_LENGTH);
+        if (memcmp(tag, in, SIM_ENVELOPE_TAG_LENGTH) != 0) {
+            return STSAFEA_INCONSISTENT_COMMAND_DATA;
+        }
+        cmd->response_length = length;
+    }
+
+    return STSAFEA_OK;
+}
+
+static StSafeA_ResponseCode_t process(stsafea_sim_t *sim, sim_command_t *cmd)
+{
+    switch (cmd->header & STSAFEA_CMD_HEADER_CODE_MSK) {
+        case STSAFEA_CMD_ECHO:
+            memcpy(cmd->response, cmd->data, cmd->length);
+            cmd->response_length = cmd->length;
+            return STSAFEA_OK;
+        case STSAFEA_CMD_RESET:
+            return (cmd->length == 0U) ? STSAFEA_OK : STSAFEA_INCONSISTENT_COMMAND_DATA;
+        case STSAFEA_CMD_GENERATE_RANDOM:
+            if ((cmd->length != 2U) || (cmd->data[0] != 0U)) {
+                return STSAFEA_INCONSISTENT_COMMAND_DATA;
+            }
+            random_fill(sim, cmd->response, cmd->data[1]);
+            cmd->response_length = cmd->data[1];
+            return STSAFEA_OK;
+        case STSAFEA_CMD_HIBERNATE:
+            if ((cmd->length != 1U)
+                    || ((cmd->data[0] != STSAFEA_WAKEUP_FROM_I2C_START_OR_RESET)
+                            && (cmd->data[0] != STSAFEA_WAKEUP_FROM_RESET))) {
+                return STSAFEA_INCONSISTENT_COMMAND_DATA;
+            }
+            sim->wake_mode = cmd->data[0];
+            return STSAFEA_OK;
+        case STSAFEA_CMD_READ:
+            return cmd_read(sim, cmd);
+        case STSAFEA_CMD_UPDATE:
+            return cmd_update(sim, cmd);
+        case STSAFEA_CMD_DECREMENT:
+            return cmd_decrement(sim, cmd);
+        case STSAFEA_CMD_QUERY:
+            return cmd_query(sim, cmd);
+        case STSAFEA_CMD_PUT_ATTRIBUTE:
+            return cmd_put_attribute(sim, cmd);
+        case STSAFEA_CMD_DELETE_KEY:
+            return cmd_delete_key(sim, cmd);
+        case STSAFEA_CMD_VERIFY_PASSWORD:
+            return cmd_verify_password(sim, cmd);
+        case STSAFEA_CMD_GENERATE_KEY:
+            return cmd_generate_key(sim, cmd);
+        case STSAFEA_CMD_GENERATE_SIGNATURE:
+            return cmd_generate_signature(sim, cmd);
+        case STSAFEA_CMD_VERIFY_SIGNATURE:
+            return cmd_verify_signature(sim, cmd);
+        case STSAFEA_CMD_ESTABLISH_KEY:
+            return cmd_establish_key(sim, cmd);
+        case STSAFEA_CMD_WRAP_LOCAL_ENVELOPE:
+            return cmd_local_envelope(sim, cmd, 1U);
+        case STSAFEA_CMD_UNWRAP_LOCAL_ENVELOPE:
+            return cmd_local_envelope(sim, cmd, 0U);
+        default:
+            return STSAFEA_UNSUPPORTED_COMMAND_CODE;
+    }
+}
+
+/* Process a command frame and prepare the response frame, returns the processing time */
+static uint32_t execute(stsafea_sim_t *sim, const uint8_t *frame, uint16_t length)
+{
+    uint8_t *response = sim->response;
+    sim_command_t cmd;
+    StSafeA_ResponseCode_t status = STSAFEA_OK;
+    uint8_t code = frame[0] & STSAFEA_CMD_HEADER_CODE_MSK;
+    uint16_t crc;
+    uint32_t busy_us;
+
+    cmd.header = frame[0];
+    cmd.data = &frame[1];
+    cmd.length = length - STSAFEA_HEADER_LENGTH - STSAFEA_CRC_LENGTH;
+    cmd.response = &response[SIM_RESPONSE_DATA];
+    cmd.response_length = 0U;
+
+    if (get_u16(&frame[length - STSAFEA_CRC_LENGTH]) != frame_crc(frame[0], cmd.data, cmd.length)) {
+        sim->crc_errors++;
+        status = STSAFEA_COMMUNICATION_ERROR;
+    } else if ((cmd.header & STSAFEA_CMD_HEADER_CMACEN) != 0U) {
+        /* The C-MAC must have been computed with the current host C-MAC sequence counter */
+        uint8_t cmac[STSAFEA_MAC_LENGTH];
+
+        if (cmd.length < STSAFEA_MAC_LENGTH) {
+            status = STSAFEA_INCONSISTENT_COMMAND_DATA;
+        } else if (sim->host_key_present == 0U) {
+            status = STSAFEA_KEY_NOT_FOUND;
+        } else if (sim->host_cmac_counter >= SIM_HOST_CMAC_COUNTER_MAX) {
+            status = STSAFEA_CMAC_COUNTER_LIMIT_REACHED;
+        } else {
+            cmd.length -= STSAFEA_MAC_LENGTH;
+            stsafea_sim_host_cmac(sim->host_cmac_counter, cmac);
+            if (memcmp(&cmd.data[cmd.length], cmac, STSAFEA_MAC_LENGTH) != 0) {
+                sim->invalid_cmacs++;
+                status = STSAFEA_INVALID_CMAC;
+            } else {
+                sim->host_cmac_counter++;
+            }
+        }
+    }
+    if (status == STSAFEA_OK) {
+        status = process(sim, &cmd);
+    }
+
+    if (status != STSAFEA_OK) {
+        cmd.response_length = 0U;
+    } else if ((cmd.header & STSAFEA_CMD_HEADER_RMACEN) != 0U) {
+        memset(&cmd.response[cmd.response_length], 0, STSAFEA_MAC_LENGTH);
+        cmd.response_length += STSAFEA_MAC_LENGTH;
+    }
+    response[0] = (uint8_t)status;
+    if ((status == STSAFEA_OK) && ((cmd.header & STSAFEA_CMD_HEADER_RMACEN) != 0U)) {
+        response[0] |= STSAFEA_CMD_HEADER_RMACEN;
+    }
+    put_u16(&response[1], cmd.response_length + STSAFEA_CRC_LENGTH);
+    crc = frame_crc(response[0], cmd.response, cmd.response_length);
+    put_u16(&cmd.response[cmd.response_length], crc);
+    sim->response_length = SIM_RESPONSE_DATA + cmd.response_length + STSAFEA_CRC_LENGTH;
+
+    sim->hibernate_pending = ((code == STSAFEA_CMD_HIBERNATE) && (status == STSAFEA_OK)) ? 1U : 0U;
+    if ((code == STSAFEA_CMD_RESET) && (status == STSAFEA_OK)) {
+        uint8_t response_frame[SIM_RESPONSE_DATA + STSAFEA_CRC_LENGTH];
+        memcpy(response_frame, sim->response, sizeof(response_frame));
+        stsafea_sim_reset(sim);
+        memcpy(sim->response, response_frame, sizeof(response_frame));
+        sim->response_length = sizeof(response_frame);
+    }
+
+    busy_us = sim->busy_us[code]
+            + (sim->busy_us_per_byte * ((uint32_t)cmd.length + cmd.response_length));
+    if (sim->jitter_us != 0U) {
+        busy_us += (uint32_t)(random_next(sim) % ((uint64_t)sim->jitter_us + 1U));
+    }
+
+    return busy_us;
+}
+
+/* A hibernating device NACKs, an I2C start wakes it up if it was put to sleep in this mode */
+static int hibernating(stsafea_sim_t *sim, uint64_t now)
+{
+    if (sim->hibernating == 0U) {
+        return 0;
+    }
+    if (sim->wake_mode == STSAFEA_WAKEUP_FROM_I2C_START_OR_RESET) {
+        sim->hibernating = 0U;
+        sim->ready_us = now + sim->wake_us;
+    }
+
+    return 1;
+}
+
+static int sim_write(stsafea_sim_t *sim, const uint8_t *data, uint16_t length, uint64_t now)
+{
+    if ((hibernating(sim, now) != 0) || (now < sim->ready_us)) {
+        sim->nacked_writes++;
+        return -1;
+    }
+    if ((length < STSAFEA_HEADER_LENGTH + STSAFEA_CRC_LENGTH)
+            || (length > STSAFEA_SIM_FRAME_MAX_LENGTH)) {
+        /* Not a frame, ignored */
+        return 0;
+    }
+
+    sim->commands++;
+    sim->ready_us = now + execute(sim, data, length);
+
+    return 0;
+}
+
+static int sim_read(stsafea_sim_t *sim, uint8_t *data, uint16_t length, uint64_t now)
+{
+    if ((hibernating(sim, now) != 0) || (now < sim->ready_us) || (sim->response_length == 0U)) {
+        sim->nacked_reads++;
+        return -1;
+    }
+
+    /* The response can be read again until the next command, beyond its end the bus reads 0xFF */
+    memset(data, 0xFF, length);
+    memcpy(data, sim->response, (length < sim->response_length) ? length : sim->response_length);
+    if (sim->hibernate_pending != 0U) {
+        sim->hibernate_pending = 0U;
+        sim->hibernating = 1U;
+        sim->response_length = 0U;
+    }
+
+    return 0;
+}
+
+void stsafea_sim_init(stsafea_sim_t *sim, uint64_t seed)
+{
+    uint16_t offset = 0;
+
+    memset(sim, 0, sizeof(*sim));
+    pthread_mutex_init(&sim->mutex, NULL);
+    stsafea_crc16x25_init();
+
+    sim->address = SIM_DEFAULT_ADDRESS;
+    sim->random = (seed != 0U) ? seed : 1U;
+    for (uint32_t i = 0; i < STSAFEA_SIM_COMMAND_NUMBER; i++) {
+        sim->busy_us[i] = 500U;
+    }
+    for (uint32_t i = 0; i < sizeof(default_busy_times) / sizeof(default_busy_times[0]); i++) {
+        sim->busy_us[default_busy_times[i].code] = default_busy_times[i].busy_us;
+    }
+    sim->busy_us_per_byte = 2U;
+    sim->wake_us = 1000U;
+
+    sim->i2c_parameter[0] = (uint8_t)(SIM_DEFAULT_ADDRESS << 1);
+    memcpy(sim->i2c_parameter_next, sim->i2c_parameter, sizeof(sim->i2c_parameter));
+
+    for (uint8_t i = 0; i < STSAFEA_SIM_ZONE_NUMBER; i++) {
+        sim->zone[i].size = zone_sizes[i];
+        sim->zone[i].offset = offset;
+        sim->zone[i].read_ac_change_right = 1U;
+        sim->zone[i].update_ac_change_right = 1U;
+        if ((i == 5U) || (i == 6U)) {
+            sim->zone[i].counter = 1U;
+            sim->zone[i].one_way_counter = SIM_ONE_WAY_COUNTER;
+        }
+        offset += zone_sizes[i];
+    }
+
+    generate_key(sim, &sim->key[0], 32U);
+}
+
+void stsafea_sim_deinit(stsafea_sim_t *sim)
+{
+    pthread_mutex_destroy(&sim->mutex);
+}
+
+void stsafea_sim_reset(stsafea_sim_t *sim)
+{
+    sim->hibernating = 0U;
+    sim->hibernate_pending = 0U;
+    sim->response_length = 0U;
+    sim->ready_us = 0U;
+    sim->key[SIM_KEY_SLOT_EPHEMERAL].present = 0U;
+    memcpy(sim->i2c_parameter, sim->i2c_parameter_next, sizeof(sim->i2c_parameter));
+    sim->address = sim->i2c_parameter[0] >> 1;
+}
+
+void stsafea_sim_host_cmac(uint32_t counter, uint8_t *cmac)
+{
+    cmac[0] = SIM_HOST_CMAC_TAG;
+    cmac[1] = (uint8_t)(counter >> 16);
+    put_u16(&cmac[2], (uint16_t)counter);
+}
+
+void stsafea_sim_attach(stsafea_sim_t *sim, stsafea_linux_bus_t *bus)
+{
+    bus->fd = -1;
+    bus->transfer = stsafea_sim_transfer;
+    bus->transfer_ctx = sim;
+}
+
+int stsafea_sim_transfer(void *transfer_ctx, struct i2c_msg *msgs, uint32_t msg_number)
+{
+    stsafea_sim_t *sim = (stsafea_sim_t *)transfer_ctx;
+    uint64_t now = monotonic_us();
+    int ret = 0;
+
+    pthread_mutex_lock(&sim->mutex);
+    for (uint32_t i = 0; (i < msg_number) && (ret == 0); i++) {
+        if (msgs[i].addr != sim->address) {
+            ret = -1;
+        } else if ((msgs[i].flags & I2C_M_RD) != 0U) {
+            ret = sim_read(sim, msgs[i].buf, msgs[i].len, now);
+        } else {
+            ret = sim_write(sim, msgs[i].buf, msgs[i].len, now);
+        }
+    }
+    pthread_mutex_unlock(&sim->mutex);
+
+    if (ret < 0) {
+        /* Address NACK, reported as by i2c-dev */
+        errno = ENXIO;
+        return -1;
+    }
+
+    return (int)msg_number;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_SIMULATOR_H_
+#define CATIE_SIXTRON_STSAFEA_SIMULATOR_H_
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "stsafea_interface_linux.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of command codes, the low 5 bits of the command header */
+#define STSAFEA_SIM_COMMAND_NUMBER 32U
+
+/* Largest frame exchanged with the device: header, length, STSAFEA_BUFFER_DATA_PACKET_SIZE data
+ * bytes, MAC and CRC */
+#define STSAFEA_SIM_FRAME_MAX_LENGTH 520U
+
+#define STSAFEA_SIM_ZONE_NUMBER 8U
+#define STSAFEA_SIM_ZONE_MEMORY_SIZE 5724U
+
+/* Private key slots 0, 1 and the ephemeral slot */
+#define STSAFEA_SIM_KEY_SLOT_NUMBER 3U
+#define STSAFEA_SIM_KEY_MAX_LENGTH 48U
+
+#define STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER 2U
+
+typedef struct {
+    uint8_t counter; /* 1 for a zone with a one-way counter */
+    uint8_t read_ac;
+    uint8_t read_ac_change_right;
+    uint8_t update_ac;
+    uint8_t update_ac_change_right;
+    uint16_t size;
+    uint16_t offset; /* In the zone memory */
+    uint32_t one_way_counter;
+} stsafea_sim_zone_t;
+
+typedef struct {
+    uint8_t present;
+    uint8_t length; /* Of a coordinate: 32 or 48 bytes */
+    uint8_t secret[STSAFEA_SIM_KEY_MAX_LENGTH];
+    uint8_t x[STSAFEA_SIM_KEY_MAX_LENGTH];
+    uint8_t y[STSAFEA_SIM_KEY_MAX_LENGTH];
+} stsafea_sim_key_t;
+
+/*
+ * In-process STSAFE-A110.
+ *
+ * The simulator implements the frame protocol (header, length, CRC16-X25, MAC bits, response
+ * codes) and the STSAFE-A110 commands of stsafea_core.c over a software data partition and key
+ * store. After a command is written, the device NACKs its address for the busy time of the
+ * command, so the polling of the middleware behaves as with the device and its cost can be
+ * measured.
+ *
+ * The cryptography is not: signatures, public keys, shared secrets and envelopes are keyed hashes
+ * with the lengths of the device. A signature generated by a simulator verifies with its public
+ * key, two simulators exchanging public keys establish the same secret and an envelope unwraps to
+ * the wrapped data. R-MACs are zeros. There are no host keys: a C-MAC must be the one of
+ * stsafea_sim_host_cmac() for the host C-MAC sequence counter of the device, so the host crypto
+ * functions of a middleware built without STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT must
+ * produce it from the counter of the initial value to use host C-MACs.
+ *
+ * The configuration fields can be changed after stsafea_sim_init(). Transfers are serialized by
+ * the simulator mutex, like those of an adapter.
+ */
+typedef struct {
+    /* Configuration */
+    uint16_t address; /* 7-bit */
+    uint32_t busy_us[STSAFEA_SIM_COMMAND_NUMBER]; /* Processing time of each command code */
+    uint32_t busy_us_per_byte; /* Added per command and response data byte */
+    uint32_t jitter_us; /* Uniformly distributed, added to each processing time */
+    uint32_t wake_us; /* Time to leave hibernation after an I2C start */
+
+    /* Counters */
+    uint32_t commands;
+    uint32_t nacked_writes; /* Commands written while the device was busy or hibernating */
+    uint32_t nacked_reads; /* Responses polled while the device was busy or hibernating */
+    uint32_t crc_errors;
+    uint32_t invalid_cmacs; /* Commands refused with STSAFEA_INVALID_CMAC */
+
+    /* State */
+    pthread_mutex_t mutex;
+    uint64_t random;
+    uint64_t ready_us;
+    uint8_t hibernating;
+    uint8_t wake_mode;
+    uint8_t hibernate_pending;
+    uint8_t response[STSAFEA_SIM_FRAME_MAX_LENGTH];
+    uint16_t response_length;
+    uint8_t i2c_parameter[2];
+    uint8_t i2c_parameter_next[2]; /* Applied at the next reset */
+    uint8_t host_key_present;
+    uint32_t host_cmac_counter;
+    uint8_t password_present;
+    uint8_t password[16];
+    uint8_t password_tries;
+    stsafea_sim_zone_t zone[STSAFEA_SIM_ZONE_NUMBER];
+    uint8_t zone_memory[STSAFEA_SIM_ZONE_MEMORY_SIZE];
+    stsafea_sim_key_t key[STSAFEA_SIM_KEY_SLOT_NUMBER];
+    uint8_t envelope_key_length[STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER]; /* 0 when absent */
+    uint8_t envelope_key[STSAFEA_SIM_ENVELOPE_KEY_SLOT_NUMBER][32];
+} stsafea_sim_t;
+
+/*
+ * Power on a personalized device: 7-bit address 0x20, eight data zones (5 and 6 with a one-way
+ * counter), a key pair in slot 0 and busy times close to those of the STSAFE-A110. The seed makes
+ * the keys and the random numbers reproducible.
+ */
+void stsafea_sim_init(stsafea_sim_t *sim, uint64_t seed);
+
+void stsafea_sim_deinit(stsafea_sim_t *sim);
+
+/* Reset through the reset pin: volatile state is lost and a pending I2C address applies */
+void stsafea_sim_reset(stsafea_sim_t *sim);
+
+/* C-MAC of a command sent with a host C-MAC sequence counter: the STSAFEA_MAC_LENGTH bytes are a
+ * tag followed by the 24-bit counter, big-endian */
+void stsafea_sim_host_cmac(uint32_t counter, uint8_t *cmac);
+
+/* Route the transfers of a Linux bus context to the simulator, instead of an adapter */
+void stsafea_sim_attach(stsafea_sim_t *sim, stsafea_linux_bus_t *bus);
+
+/* Transfer function of stsafea_linux_bus_t, transfer_ctx being the simulator */
+int stsafea_sim_transfer(void *transfer_ctx, struct i2c_msg *msgs, uint32_t msg_number);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_SIMULATOR_H_
@@ -153,6 +153,56 @@ extern "C" {
   */
 
 
+/** @defgroup STSAFE_A100_Commands_Min_Wait_Time STSAFE-A100's minimum waiting time before polling the response
+  * @brief STSAFE-A100 Commands minimum waiting time in ms between command and first response polling.
+  *        Only used if STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING = 1.
+  * @{
+  */
+/*!< Echo: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_ECHO                     (  2U)
+/*!< Reset: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_RESET                    ( 10U)
+/*!< generate Random: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_RANDOM          (  2U)
+/*!< Start Session: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_START_SESSION            ( 10U)
+/*!< Decrement: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_DECREMENT                (  5U)
+/*!< Read: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_READ                     ( 10U)
+/*!< Update: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_UPDATE                   ( 10U)
+/*!< Hibernate: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_HIBERNATE                ( 10U)
+/*!< Wrap Local Envelope: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_WRAP_LOCAL_ENVELOPE      ( 10U)
+/*!< Unwrap Local Envelope: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_UNWRAP_LOCAL_ENVELOPE    ( 10U)
+/*!< Put Attribute: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_PUT_ATTRIBUTE            (  5U)
+/*!< Generate Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_KEY             ( 55U)
+/*!< Delete Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_DELETE_KEY               (  5U)
+/*!< Query: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_QUERY                    (  1U)
+/*!< Get Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GET_SIGNATURE            ( 50U)
+/*!< Generate Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_SIGNATURE       ( 40U)
+/*!< Verify Message Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_MSG_SIGNATURE     ( 75U)
+/*!< Verify Entity Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_ENTITY_SIGNATURE  ( 75U)
+/*!< Establish Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_ESTABLISH_KEY            ( 85U)
+/*!< Verify Password: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_PASSWORD          (  5U)
+/**
+  * @}
+  */
+
+
 /** @defgroup STSAFE_A100_Commands_Tag STSAFE-A100's command tags
   * @brief STSAFEA-100 Commands Tag
   * @{
@@ -158,6 +158,52 @@ extern "C" {
   */
 
 
+/** @defgroup STSAFE_A110_Commands_Min_Wait_Time STSAFE-A110's minimum waiting time before polling the response
+  * @brief STSAFE-A110 Commands minimum waiting time in ms between command and first response polling.
+  *        Only used if STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING = 1.
+  * @{
+  */
+/*!< Echo: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_ECHO                     (  0U)
+/*!< Reset: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_RESET                    ( 10U)
+/*!< generate Random: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_RANDOM          (  2U)
+/*!< Start Session: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_START_SESSION            ( 10U)
+/*!< Decrement: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_DECREMENT                (  5U)
+/*!< Read: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_READ                     (  0U)
+/*!< Update: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_UPDATE                   (  5U)
+/*!< Hibernate: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_HIBERNATE                ( 10U)
+/*!< Wrap Local Envelope: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_WRAP_LOCAL_ENVELOPE      (  5U)
+/*!< Unwrap Local Envelope: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_UNWRAP_LOCAL_ENVELOPE    (  5U)
+/*!< Put Attribute: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_PUT_ATTRIBUTE            (  5U)
+/*!< Generate Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_KEY             ( 80U)
+/*!< Delete Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_DELETE_KEY               (  5U)
+/*!< Query: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_QUERY                    (  0U)
+/*!< Generate Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_SIGNATURE       ( 40U)
+/*!< Verify Message Signature: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_MSG_SIGNATURE     ( 75U)
+/*!< Establish Key: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_ESTABLISH_KEY            (130U)
+/*!< Verify Password: Minimum delay in ms before polling the response. */
+#define STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_PASSWORD          (  5U)
+/**
+  * @}
+  */
+
+
 /** @defgroup STSAFE_A110_Commands_Tag STSAFE-A110's command tags
   * @brief STSAFE-A110 Commands Tag
   * @{
@@ -203,22 +203,24 @@ extern "C" {
                                                    STSAFEA_SIGN_ECDSA_SHA384_LENGTH : 0U)
 /* Note: Consider to rework the following code in the next release.
    It generates a not-clear and not-readable return in the middle of functions that should be avoided */
-#define STSAFEA_CHECK_SIZE(mac, index, size)                                        \
-  {                                                                                  \
-    if (mac == STSAFEA_MAC_NONE)                                                     \
-    {                                                                                \
-      if ((size + index ) > STSAFEA_BUFFER_DATA_CONTENT_SIZE)                        \
-      {                                                                              \
-        return STSAFEA_BUFFER_LENGTH_EXCEEDED;                                       \
-      }                                                                              \
-    }                                                                                \
-    else                                                                             \
-    {                                                                                \
-      if ((size + index ) > (STSAFEA_BUFFER_DATA_CONTENT_SIZE - STSAFEA_MAC_LENGTH)) \
-      {                                                                              \
-        return STSAFEA_BUFFER_LENGTH_EXCEEDED;                                       \
-      }                                                                              \
-    }                                                                                \
+#define STSAFEA_BUFFER_CONTENT_SIZE(handle)  ((handle)->HwCtx.BufferPacketSize - STSAFEA_HEADER_LENGTH - \
+                                              STSAFEA_CRC_LENGTH)
+#define STSAFEA_CHECK_SIZE(handle, mac, index, size)                                              \
+  {                                                                                                \
+    if (mac == STSAFEA_MAC_NONE)                                                                   \
+    {                                                                                              \
+      if ((size + index ) > STSAFEA_BUFFER_CONTENT_SIZE(handle))                                   \
+      {                                                                                            \
+        return STSAFEA_BUFFER_LENGTH_EXCEEDED;                                                     \
+      }                                                                                            \
+    }                                                                                              \
+    else                                                                                           \
+    {                                                                                              \
+      if ((size + index ) > (STSAFEA_BUFFER_CONTENT_SIZE(handle) - STSAFEA_MAC_LENGTH))            \
+      {                                                                                            \
+        return STSAFEA_BUFFER_LENGTH_EXCEEDED;                                                     \
+      }                                                                                            \
+    }                                                                                              \
   }
 /**
   * @}
@@ -248,12 +250,77 @@ extern "C" {
  ===============================================================================
 [..]
     (+) Init
+    (+) Init Device
+    (+) Get / Set Latency Model
+    (+) Set Retry Policy / Deadline / Buffer Size / In-place Responses
+    (+) Get / Reset Statistics
+    (+) Get / Reset Profile
+    (+) Read Trace
 @endverbatim
   * @{
   */
 StSafeA_ResponseCode_t StSafeA_Init(
   StSafeA_Handle_t *pStSafeA,
   uint8_t *pAllocatedRxTxBufferData);
+
+StSafeA_ResponseCode_t StSafeA_InitDevice(
+  StSafeA_Handle_t *pStSafeA,
+  uint8_t *pAllocatedRxTxBufferData,
+  void *pBusCtx,
+  uint16_t DevAddr);
+
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+StSafeA_ResponseCode_t StSafeA_GetLatencyModel(
+  StSafeA_Handle_t *pStSafeA,
+  StSafeA_LatencyModel_t *pOutLatencyModel);
+
+StSafeA_ResponseCode_t StSafeA_SetLatencyModel(
+  StSafeA_Handle_t *pStSafeA,
+  const StSafeA_LatencyModel_t *pInLatencyModel);
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
+StSafeA_ResponseCode_t StSafeA_SetRetryPolicy(
+  StSafeA_Handle_t *pStSafeA,
+  const StSafeA_RetryPolicy_t *pInRetryPolicy);
+
+StSafeA_ResponseCode_t StSafeA_SetDeadline(
+  StSafeA_Handle_t *pStSafeA,
+  uint32_t MsDeadline);
+
+StSafeA_ResponseCode_t StSafeA_SetBufferSize(
+  StSafeA_Handle_t *pStSafeA,
+  uint16_t BufferSize);
+
+StSafeA_ResponseCode_t StSafeA_SetInPlaceResponse(
+  StSafeA_Handle_t *pStSafeA,
+  uint8_t InPlaceResponse);
+
+#if (STSAFEA_USE_STATISTICS)
+StSafeA_ResponseCode_t StSafeA_GetStatistics(
+  StSafeA_Handle_t *pStSafeA,
+  StSafeA_Statistics_t *pOutStatistics);
+
+StSafeA_ResponseCode_t StSafeA_ResetStatistics(
+  StSafeA_Handle_t *pStSafeA);
+#endif /* STSAFEA_USE_STATISTICS */
+
+#if (STSAFEA_USE_PROFILING)
+StSafeA_ResponseCode_t StSafeA_GetProfile(
+  StSafeA_Handle_t *pStSafeA,
+  StSafeA_Profile_t *pOutProfile);
+
+StSafeA_ResponseCode_t StSafeA_ResetProfile(
+  StSafeA_Handle_t *pStSafeA);
+#endif /* STSAFEA_USE_PROFILING */
+
+#if (STSAFEA_USE_TRACE)
+StSafeA_ResponseCode_t StSafeA_ReadTrace(
+  StSafeA_Handle_t *pStSafeA,
+  StSafeA_TraceEntry_t *pOutEntries,
+  uint16_t InMaxNumber,
+  uint16_t *pOutNumber,
+  uint32_t *pOutDropped);
+#endif /* STSAFEA_USE_TRACE */
 /**
   * @}
   */
@@ -39,24 +39,7 @@ extern "C" {
 
 
 /* Exported types ------------------------------------------------------------*/
-/** @addtogroup SERVICE_Exported_Types
-  * @{
-  */
-typedef struct
-{
-  int32_t (* IOInit)(void);
-  int32_t (* BusInit)(void);
-  int32_t (* BusDeInit)(void);
-  int32_t (* BusRecv)(uint16_t address, uint8_t *, uint16_t);
-  int32_t (* BusSend)(uint16_t address, uint8_t *, uint16_t);
-  void (* TimeDelay)(uint32_t msDelay);
-  int32_t (*CrcInit)(void);
-  uint32_t (*CrcCompute)(uint8_t *pData1, uint16_t Length1, uint8_t *pData2, uint16_t Length2);
-  uint16_t DevAddr;
-} STSAFEA_HW_t;
-/**
-  * @}
-  */
+/* STSAFEA_HW_t is defined in stsafea_types.h, as part of the StSafeA_Handle_t */
 
 /* Exported constants --------------------------------------------------------*/
 /** @addtogroup SERVICE_Error_Constants Generic Low Level error definitions to maintain platform independency
@@ -65,6 +48,7 @@ typedef struct
 #define STSAFEA_BUS_OK   ( 0)
 #define STSAFEA_BUS_ERR  (-1)
 #define STSAFEA_BUS_NACK ( 1)
+#define STSAFEA_BUS_TIMEOUT ( 2)   /*!< Deadline of the command reached while the device NACKs the bus phase */
 
 /**
   * @}
@@ -73,6 +57,21 @@ typedef struct
 /* External variables --------------------------------------------------------*/
 
 /* Exported macros -----------------------------------------------------------*/
+/*!< Measure the host processing time of a section, compiled out when STSAFEA_USE_PROFILING = 0 */
+#if (STSAFEA_USE_PROFILING)
+#define STSAFEA_PROFILE_BEGIN(pHwCtx, Section) StSafeA_ProfileBegin((pHwCtx), (uint8_t)(Section))
+#define STSAFEA_PROFILE_END(pHwCtx, Section)   StSafeA_ProfileEnd((pHwCtx), (uint8_t)(Section))
+#else
+#define STSAFEA_PROFILE_BEGIN(pHwCtx, Section) ((void)0U)
+#define STSAFEA_PROFILE_END(pHwCtx, Section)   ((void)0U)
+#endif /* STSAFEA_USE_PROFILING */
+
+/*!< Record the end of a command phase, compiled out when STSAFEA_USE_TRACE = 0 */
+#if (STSAFEA_USE_TRACE)
+#define STSAFEA_TRACE(pHwCtx, Phase, Value)    StSafeA_TraceRecord((pHwCtx), (uint8_t)(Phase), (uint16_t)(Value))
+#else
+#define STSAFEA_TRACE(pHwCtx, Phase, Value)    ((void)0U)
+#endif /* STSAFEA_USE_TRACE */
 
 /* Exported functions ------------------------------------------------------- */
 /** @addtogroup SERVICE_Exported_Functions
@@ -90,7 +89,7 @@ typedef struct
 @endverbatim
   * @{
   */
-int8_t StSafeA_HW_Init(void);
+int8_t StSafeA_HW_Init(STSAFEA_HW_t *pHwCtx);
 /**
   * @}
   */
@@ -108,9 +107,18 @@ int8_t StSafeA_HW_Init(void);
   * @{
   */
 
-StSafeA_ResponseCode_t StSafeA_Transmit(StSafeA_TLVBuffer_t *pTLV_Buffer, uint8_t CrcSupport);
-StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer, uint8_t CrcSupport);
-void                   StSafeA_Delay(uint32_t msDelay);
+StSafeA_ResponseCode_t StSafeA_Transmit(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer, uint8_t CrcSupport);
+StSafeA_ResponseCode_t StSafeA_Receive(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer, uint8_t CrcSupport);
+void                   StSafeA_Delay(STSAFEA_HW_t *pHwCtx, uint32_t msDelay);
+uint32_t               StSafeA_GetResponsePollingTime(STSAFEA_HW_t *pHwCtx);
+#if (STSAFEA_USE_PROFILING)
+void                   StSafeA_ProfileBegin(STSAFEA_HW_t *pHwCtx, uint8_t Section);
+void                   StSafeA_ProfileEnd(STSAFEA_HW_t *pHwCtx, uint8_t Section);
+#endif /* STSAFEA_USE_PROFILING */
+#if (STSAFEA_USE_TRACE)
+void                   StSafeA_TraceRecord(STSAFEA_HW_t *pHwCtx, uint8_t Phase, uint16_t Value);
+uint16_t               StSafeA_TraceRead(STSAFEA_HW_t *pHwCtx, StSafeA_TraceEntry_t *pEntries, uint16_t MaxNumber);
+#endif /* STSAFEA_USE_TRACE */
 /**
   * @}
   */
@@ -53,6 +53,8 @@ extern "C" {
 #define STSAFEA_HEADER_LENGTH                      0x01U    /*!< Header length */
 #define STSAFEA_LENGTH_SIZE                        0x02U    /*!< Length size */
 #define STSAFEA_CRC_LENGTH                         0x02U    /*!< CRC length */
+#define STSAFEA_CRC_NOT_ACCUMULATED                0xFFFFU  /*!< No command CRC accumulated in STSAFEA_HW_t */
+#define STSAFEA_NO_DEADLINE                        0xFFFFFFFFU  /*!< No time limit to the current command */
 #define STSAFEA_MAC_LENGTH                         0x04U    /*!< MAC length */
 #define STSAFEA_HASH_LENGTH                        0x04U    /*!< HASH length */
 #define STSAFEA_ST_NUMBER_LENGTH                   0x09U    /*!< ST number length */
@@ -70,16 +72,47 @@ extern "C" {
                                                 STSAFEA_CRC_LENGTH) /*!< Data size in bytes */
 #define STSAFEA_BUFFER_DATA_EXTENSION_SIZE     16U /*!< Additional 16 bytes = 2 Bytes CRC + 10 extra bytes used during
                                                         RMAC calculation + 4 spare bytes
-                                                        used for optimization by the Low Level layer to move bytes
-                                                        inside the same buffer */
+                                                        used for optimization by the Low Level layer, starting
+                                                        with the headroom in front of the data */
+#define STSAFEA_BUFFER_HEADROOM_SIZE           (STSAFEA_HEADER_LENGTH + \
+                                                STSAFEA_LENGTH_SIZE) /*!< Bytes reserved in front of the data,
+                                                        so that the Low Level layer builds/receives the frame
+                                                        header in place */
 /*!< Max extended buffer size in bytes */
 #define STSAFEA_BUFFER_MAX_SIZE                (STSAFEA_BUFFER_DATA_PACKET_SIZE + STSAFEA_BUFFER_DATA_EXTENSION_SIZE)
+/*!< Extended buffer size in bytes for commands and responses of up to DATA_SIZE data bytes, see
+     StSafeA_SetBufferSize */
+#define STSAFEA_BUFFER_SIZE(DATA_SIZE)         ((DATA_SIZE) + STSAFEA_HEADER_LENGTH + STSAFEA_CRC_LENGTH + \
+                                                STSAFEA_BUFFER_DATA_EXTENSION_SIZE)
+#define STSAFEA_BUFFER_MIN_DATA_SIZE           64U /*!< Smallest data size of a reduced buffer: the commands
+                                                        built without checking the buffer size are shorter */
 #define STSAFEA_ATOMICITY_BUFFER_SIZE          64U /*!< Atomicity buffer size in bytes */
 /**
   * @}
   */
 
 
+/** @defgroup STSAFEA_Latency_Model_Sizes Command processing time model sizes
+  * @{
+  */
+#ifndef STSAFEA_LATENCY_MODEL_BIN_NUMBER
+#define STSAFEA_LATENCY_MODEL_BIN_NUMBER        8U /*!< Number of histogram bins per command code */
+#endif /* STSAFEA_LATENCY_MODEL_BIN_NUMBER */
+/**
+  * @}
+  */
+
+/** @defgroup STSAFEA_Trace_Sizes Command phase trace sizes
+  * @{
+  */
+#ifndef STSAFEA_TRACE_RING_SIZE
+#define STSAFEA_TRACE_RING_SIZE                64U /*!< Number of trace entries, must be a power of 2 */
+#endif /* STSAFEA_TRACE_RING_SIZE */
+/**
+  * @}
+  */
+
+
 /** @defgroup STSAFEA_MAC_Options Bits definition for MAC through command header
   * @{
   */
@@ -106,6 +139,10 @@ extern "C" {
 #define STSAFEA_CMD_HEADER_MAC_MSK              (STSAFEA_CMD_HEADER_CMAC_MSK | \
                                                  STSAFEA_CMD_HEADER_RMAC_MSK | \
                                                  STSAFEA_CMD_HEADER_SCHN_MSK)
+/*!< Command code bits */
+#define STSAFEA_CMD_HEADER_CODE_MSK             ((uint8_t)0x1F)
+/*!< Number of command codes, sizing the tables indexed by command code */
+#define STSAFEA_CMD_CODE_NUMBER                 32U
 /*!< No MAC */
 #define  STSAFEA_MAC_NONE        (0x0U)
 /*!< Regular Command MAC  */
@@ -561,7 +598,8 @@ typedef enum
   STSAFEA_INVALID_CRC                  = 0x22U,
   STSAFEA_INVALID_PARAMETER            = 0x30U,
   STSAFEA_INVALID_RESP_LENGTH          = 0x31U,
-  STSAFEA_COMMUNICATION_NACK           = 0x32U
+  STSAFEA_COMMUNICATION_NACK           = 0x32U,
+  STSAFEA_COMMUNICATION_TIMEOUT        = 0x33U
 } StSafeA_ResponseCode_t;
 
 /*!
@@ -830,6 +868,248 @@ typedef struct
   uint8_t                 HashRes[STSAFEA_SHA_384_LENGTH];
 } StSafeA_Hash_t;
 
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+/*!
+ * \struct StSafeA_LatencyHistogram_t
+ * \brief Command processing time histogram structure type definition
+ * \details Distribution of the processing times measured for one command code.
+ *          Bin i counts the responses available between i * BinWidth and (i + 1) * BinWidth ms after the
+ *          command transmission. The last bin also counts all the longer processing times.
+ */
+typedef struct
+{
+  uint8_t BinWidth;                                        /*!< Bin width in ms, 0 if nothing has been recorded */
+  uint8_t Bins[STSAFEA_LATENCY_MODEL_BIN_NUMBER];          /*!< Number of responses per bin */
+} StSafeA_LatencyHistogram_t;
+
+/*!
+ * \struct StSafeA_LatencyModel_t
+ * \brief Command processing time model structure type definition
+ * \details Learned processing time histograms, indexed by command code.
+ *          Can be retrieved with StSafeA_GetLatencyModel and stored by the application,
+ *          then preloaded at boot with StSafeA_SetLatencyModel.
+ */
+typedef struct
+{
+  StSafeA_LatencyHistogram_t Cmd[STSAFEA_CMD_CODE_NUMBER];  /*!< Histogram per command code */
+} StSafeA_LatencyModel_t;
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
+/*!
+ * \enum StSafeA_RetryBackoff_t
+ * \brief Delays between the attempts of a bus phase NACKed by the busy device
+ */
+typedef enum
+{
+  STSAFEA_RETRY_FIXED       = 0x0U,    /*!< Same delay between all the attempts */
+  STSAFEA_RETRY_EXPONENTIAL = 0x1U     /*!< Delay doubled after each attempt, up to MaxDelay */
+} StSafeA_RetryBackoff_t;
+
+/*!
+ * \struct StSafeA_RetryPolicy_t
+ * \brief Bus retry policy structure type definition
+ * \details How the command sending and the response reading are retried while the device NACKs them.
+ *          Set with StSafeA_SetRetryPolicy. The all zero policy is the default one: fixed
+ *          STSAFEA_I2C_POLLING_STEP delays during STSAFEA_I2C_POLLING_MAX ms.
+ */
+typedef struct
+{
+  StSafeA_RetryBackoff_t Backoff;      /*!< Delays progression */
+  uint16_t InitialDelay;               /*!< First delay in ms, 0 for the polling step of the bus phase */
+  uint16_t MaxDelay;                   /*!< Maximum delay in ms with STSAFEA_RETRY_EXPONENTIAL, 0 for no maximum */
+  uint32_t Timeout;                    /*!< Maximum delay in ms spent in a bus phase, 0 for STSAFEA_I2C_POLLING_MAX */
+  uint32_t BusyPollTime;               /*!< Time in us attempts are repeated without delay at the start of a bus
+                                            phase. Requires the TimeGetUs function of the bus layer */
+} StSafeA_RetryPolicy_t;
+
+#if (STSAFEA_USE_STATISTICS)
+/*!
+ * \struct StSafeA_CommandStatistics_t
+ * \brief Communication statistics structure type definition
+ * \details Counters of the commands with a given command code, or of all the commands.
+ */
+typedef struct
+{
+  uint32_t Commands;                   /*!< Commands transmitted */
+  uint32_t NackRetries;                /*!< Bus attempts failed, mostly NACKed by the busy device, and retried */
+  uint32_t CrcErrors;                  /*!< Responses rejected with STSAFEA_INVALID_CRC */
+  uint32_t ReReads;                    /*!< Responses longer than expected, read a second time */
+  uint32_t BytesSent;                  /*!< Bytes of the frames sent, CRC included */
+  uint32_t BytesReceived;              /*!< Bytes of the frames received, re-reads and CRC included */
+  uint32_t WaitTime;                   /*!< Time in ms spent delaying for the device, processing and retries */
+} StSafeA_CommandStatistics_t;
+
+/*!
+ * \struct StSafeA_Statistics_t
+ * \brief Communication statistics snapshot structure type definition
+ * \details Retrieved with StSafeA_GetStatistics.
+ */
+typedef struct
+{
+  StSafeA_CommandStatistics_t Total;                                   /*!< All the commands */
+  StSafeA_CommandStatistics_t Cmd[STSAFEA_CMD_CODE_NUMBER];            /*!< Per command code */
+} StSafeA_Statistics_t;
+#endif /* STSAFEA_USE_STATISTICS */
+
+#if (STSAFEA_USE_PROFILING)
+/*!
+ * \enum StSafeA_ProfileSection_t
+ * \brief Host processing sections measured by the profiling build
+ */
+typedef enum
+{
+  STSAFEA_PROFILE_CRC        = 0x0U,   /*!< Command CRC computation and response CRC check */
+  STSAFEA_PROFILE_COPY       = 0x1U,   /*!< Copy of the command fields into the I/O buffer */
+  STSAFEA_PROFILE_CMAC       = 0x2U,   /*!< StSafeA_ComputeCMAC */
+  STSAFEA_PROFILE_RMAC       = 0x3U,   /*!< StSafeA_ComputeRMAC */
+  STSAFEA_PROFILE_ENCRYPTION = 0x4U,   /*!< StSafeA_DataEncryption */
+  STSAFEA_PROFILE_DECRYPTION = 0x5U,   /*!< StSafeA_DataDecryption */
+  STSAFEA_PROFILE_NUMBER     = 0x6U    /*!< Number of sections */
+} StSafeA_ProfileSection_t;
+
+/*!
+ * \struct StSafeA_ProfileCounter_t
+ * \brief Host processing time of one section
+ * \details Times are in units of the CycleCount function of the bus layer: CPU cycles on Cortex-M, nanoseconds
+ *          on hosts. Only Calls is counted without CycleCount.
+ */
+typedef struct
+{
+  uint32_t Calls;                      /*!< Number of executions */
+  uint64_t Cycles;                     /*!< Total time */
+  uint32_t MaxCycles;                  /*!< Longest execution */
+  uint32_t Start;                      /*!< CycleCount value at the start of the running execution */
+} StSafeA_ProfileCounter_t;
+
+/*!
+ * \struct StSafeA_Profile_t
+ * \brief Host processing time profile structure type definition
+ * \details Retrieved with StSafeA_GetProfile.
+ */
+typedef struct
+{
+  StSafeA_ProfileCounter_t Section[STSAFEA_PROFILE_NUMBER];  /*!< Per StSafeA_ProfileSection_t */
+} StSafeA_Profile_t;
+#endif /* STSAFEA_USE_PROFILING */
+
+#if (STSAFEA_USE_TRACE)
+/*!
+ * \enum StSafeA_TracePhase_t
+ * \brief Command phases recorded in the trace
+ * \details Each entry is recorded at the end of its phase, so that the phase lasted from the previous entry of the
+ *          same command to this one.
+ */
+typedef enum
+{
+  STSAFEA_TRACE_PHASE_START     = 0x0U,  /*!< Command build started, Value is the command header */
+  STSAFEA_TRACE_PHASE_BUILD     = 0x1U,  /*!< Command fields copied into the I/O buffer */
+  STSAFEA_TRACE_PHASE_MAC_PRE   = 0x2U,  /*!< C-MAC and hash pre-processing */
+  STSAFEA_TRACE_PHASE_CRC       = 0x3U,  /*!< Command CRC */
+  STSAFEA_TRACE_PHASE_BUS_WRITE = 0x4U,  /*!< Command sending, Value is the number of NACKed attempts */
+  STSAFEA_TRACE_PHASE_WAIT      = 0x5U,  /*!< Wait for the command processing, Value is the delay in ms */
+  STSAFEA_TRACE_PHASE_BUS_READ  = 0x6U,  /*!< Response reading, Value is the number of NACKed attempts */
+  STSAFEA_TRACE_PHASE_CRC_CHECK = 0x7U,  /*!< Response CRC check */
+  STSAFEA_TRACE_PHASE_MAC_POST  = 0x8U,  /*!< R-MAC and hash post-processing */
+  STSAFEA_TRACE_PHASE_END       = 0x9U   /*!< Command completed, Value is the response code */
+} StSafeA_TracePhase_t;
+
+/*!
+ * \struct StSafeA_TraceEntry_t
+ * \brief Command phase trace entry structure type definition
+ */
+typedef struct
+{
+  uint32_t Timestamp;                  /*!< End of the phase in us, from the TimeGetUs function of the bus layer */
+  uint8_t  Header;                     /*!< Header of the command */
+  uint8_t  Phase;                      /*!< StSafeA_TracePhase_t */
+  uint16_t Value;                      /*!< Phase dependent value, see StSafeA_TracePhase_t */
+} StSafeA_TraceEntry_t;
+
+/*!
+ * \struct StSafeA_TraceRing_t
+ * \brief Command phase trace ring buffer structure type definition
+ * \details Single producer, single consumer ring: entries are only written by the thread operating the device and
+ *          read with StSafeA_ReadTrace, possibly from another thread, without lock. Entries are dropped when the
+ *          ring is full.
+ */
+typedef struct
+{
+  StSafeA_TraceEntry_t Entry[STSAFEA_TRACE_RING_SIZE];  /*!< Ring storage */
+  volatile uint32_t Head;              /*!< Number of entries written, only modified by the writer */
+  volatile uint32_t Tail;              /*!< Number of entries read, only modified by the reader */
+  volatile uint32_t Dropped;           /*!< Number of entries dropped because the ring was full */
+  uint8_t  Header;                     /*!< Header of the command being traced */
+} StSafeA_TraceRing_t;
+#endif /* STSAFEA_USE_TRACE */
+
+/*!
+ * \struct STSAFEA_HW_t
+ * \brief Hardware context structure type definition
+ * \details IO, bus and timing functions used to operate one STSAFE-A1xx device, filled by StSafeA_HW_Probe.
+ *          pBusCtx is passed to the IO and bus functions, so that several devices can be operated on
+ *          different buses.
+ *          When CrcUpdate is provided, the command CRC is accumulated in TxCrc while the command fields are
+ *          copied into the I/O buffer, and the response CRC is accumulated by BusRecvFrame while the bytes arrive,
+ *          instead of running over the whole frame once it is complete.
+ */
+typedef struct
+{
+  int32_t (* IOInit)(void *pBusCtx);
+  int32_t (* BusInit)(void *pBusCtx);
+  int32_t (* BusDeInit)(void *pBusCtx);
+  int32_t (* BusRecv)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t);
+  int32_t (* BusSend)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t);
+  /* Optional (NULL if not supported): read the 3 bytes response header, then exactly the announced length,
+     within the same bus transaction, without exceeding the given max length. On success, if pCrc is not NULL, also
+     return there the CRC register (as CrcUpdate) over the header and the received data but its last 2 bytes */
+  int32_t (* BusRecvFrame)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t, uint16_t *pCrc);
+  void (* TimeDelay)(uint32_t msDelay);
+  /* Optional (NULL if not supported): delay taking pBusCtx, used instead of TimeDelay when provided */
+  void (* BusDelay)(void *pBusCtx, uint32_t msDelay);
+  int32_t (*CrcInit)(void);
+  uint32_t (*CrcCompute)(uint8_t *pData1, uint16_t Length1, uint8_t *pData2, uint16_t Length2);
+  /* Optional (NULL if not supported): continue a CRC16-X25 register (initial value 0xFFFF, no final inversion)
+     with Length bytes of pSrc, also copying them to pDest if not NULL */
+  uint16_t (*CrcUpdate)(uint16_t Crc, uint8_t *pDest, const uint8_t *pSrc, uint16_t Length);
+  /* Optional (NULL if not supported): free running microseconds counter, used to busy-poll the device */
+  uint32_t (* TimeGetUs)(void);
+  /* Optional (NULL if not supported): free running CPU cycles counter, used by STSAFEA_USE_PROFILING */
+  uint32_t (* CycleCount)(void);
+  uint16_t DevAddr;
+  void     *pBusCtx;                   /*!< Application bus context, NULL for the default bus */
+  uint32_t ResponsePollingTime;        /*!< Time in ms spent polling before the last response was available */
+  uint16_t TxCrc;                      /*!< CRC register over TxCrcHeader and the first TxCrcLength command bytes */
+  uint16_t TxCrcLength;                /*!< Command bytes in TxCrc, STSAFEA_CRC_NOT_ACCUMULATED if none */
+  uint8_t  TxCrcHeader;                /*!< Command header the TxCrc accumulation started with */
+  StSafeA_RetryPolicy_t RetryPolicy;   /*!< Retry policy of the bus phases NACKed by the device */
+  uint32_t Deadline;                   /*!< Maximum time in ms a command waits for the device, 0 for no deadline */
+  uint32_t TimeLeft;                   /*!< Time left in ms to the current command, STSAFEA_NO_DEADLINE if none */
+  uint32_t CommandStart;               /*!< TimeGetUs value at the start of the current command */
+  uint16_t BufferPacketSize;           /*!< Frame bytes the I/O buffer holds, see StSafeA_SetBufferSize */
+#if (STSAFEA_USE_STATISTICS)
+  StSafeA_CommandStatistics_t Stats[STSAFEA_CMD_CODE_NUMBER];  /*!< Counters per command code */
+  uint8_t  StatsCmd;                   /*!< Code of the command being counted */
+#endif /* STSAFEA_USE_STATISTICS */
+#if (STSAFEA_USE_PROFILING)
+  StSafeA_Profile_t Profile;           /*!< Host processing time of the driver */
+#endif /* STSAFEA_USE_PROFILING */
+#if (STSAFEA_USE_TRACE)
+  StSafeA_TraceRing_t Trace;           /*!< Phases of the last commands */
+#endif /* STSAFEA_USE_TRACE */
+} STSAFEA_HW_t;
+
+/*!
+ * \struct StSafeA_RMac_t
+ * \brief R-MAC structure type definition
+ * \details R-MAC computation state, started when the command C-MAC is computed and completed on the response.
+ */
+typedef struct
+{
+  void    *pAesRMacCtx;                /*!< AES CMAC context of the R-MAC computation */
+  uint8_t aRMacBuffer[16];             /*!< Bytes waiting to be processed as a full AES block */
+  uint8_t RMacBufferSize;              /*!< Number of bytes in aRMacBuffer */
+} StSafeA_RMac_t;
+
 /*!
  * \struct StSafeA_Handle_t
  * \brief STSAFEA handler structure type definition
@@ -841,7 +1121,18 @@ typedef struct
   uint8_t              CrcSupport;                                /*!< STSAFE_A's COM CRC feature support */
   uint8_t              MacCounter;                                /*!< MAC counter for peripheral MACs */
   uint32_t             HostMacSequenceCounter;                    /*!< Host-MAC counter */
+  uint8_t              HostMacSequenceCounterPending;             /*!< Host-MAC counter increment pending */
+  uint32_t             CommandCounter;                            /*!< Commands transmitted since StSafeA_InitDevice,
+                                                                       each overwriting the I/O buffer */
+  uint8_t              InPlaceResponse;                           /*!< Output LV buffers with a NULL Data point inside
+                                                                       the I/O buffer, see StSafeA_SetInPlaceResponse */
   StSafeA_Hash_t       HashObj;
+  StSafeA_RMac_t       RMacObj;                                   /*!< STSAFE_A's R-MAC computation state */
+  STSAFEA_HW_t         HwCtx;                                     /*!< STSAFE_A's IO and bus context */
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+  StSafeA_LatencyModel_t LatencyModel;                            /*!< Learned command processing times */
+  uint32_t             WaitTime;                                  /*!< Delay in ms applied before the last response */
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
 } StSafeA_Handle_t;
 
 /**
@@ -52,6 +52,14 @@
 
 
 /* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief Command descriptor: processing times of a command code
+  */
+typedef struct
+{
+  uint16_t MsWaitTime;     /*!< Worst case processing time in ms */
+  uint16_t MsMinWaitTime;  /*!< Minimum processing time in ms */
+} StSafeA_CommandDescriptor_t;
 
 /* Private defines -----------------------------------------------------------*/
 /** @addtogroup CORE_Private_Constants
@@ -104,28 +112,108 @@
 #define STSAFEA_WRAP_UNWRAP_ENVELOPE_ADDITIONAL_RESPONSE_LENGTH         ((uint16_t)8)
 /*!< Response length to I2C parameters query */
 #define STSAFEA_VERIFY_PASSWORD_RESPONSE_LENGTH                         ((uint16_t)2)
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+/*!< Percentile of the learned processing times to wait for before polling the response */
+#ifndef STSAFEA_LATENCY_MODEL_PERCENTILE
+#define STSAFEA_LATENCY_MODEL_PERCENTILE                                20U
+#endif /* STSAFEA_LATENCY_MODEL_PERCENTILE */
+/*!< Number of recorded responses needed before the learned processing times are used */
+#ifndef STSAFEA_LATENCY_MODEL_MIN_SAMPLES
+#define STSAFEA_LATENCY_MODEL_MIN_SAMPLES                               4U
+#endif /* STSAFEA_LATENCY_MODEL_MIN_SAMPLES */
+/*!< Histogram bin saturation value. All the bins of the command are halved when reached */
+#define STSAFEA_LATENCY_MODEL_BIN_MAX                                   ((uint8_t)0xFF)
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
 /**
   * @}
   */
 
 /* Private macros ------------------------------------------------------------*/
+/*!< Output LV buffer check: a NULL Data is accepted when the response is left in place, see
+     StSafeA_SetInPlaceResponse */
+#define IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(HANDLER, PTR)                   \
+  (((HANDLER)->InPlaceResponse != STSAFEA_FLAG_FALSE) ? ((PTR) != NULL) : \
+   IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(PTR))
 
 /* Private variables ---------------------------------------------------------*/
 #define WORKAROUND_GENERATE_SIGNATURE /* STSAFE-A1x0 hangs when hash containing only NULL bytes */
 
+/* The highest command code of the command header must index the tables sized by STSAFEA_CMD_CODE_NUMBER */
+_Static_assert(STSAFEA_CMD_HEADER_CODE_MSK < STSAFEA_CMD_CODE_NUMBER, "command codes exceed STSAFEA_CMD_CODE_NUMBER");
+
+/* Command descriptors, indexed by the command code of the command header */
+static const StSafeA_CommandDescriptor_t StSafeA_CommandTable[STSAFEA_CMD_CODE_NUMBER] =
+{
+  [STSAFEA_CMD_ECHO]                  = {STSAFEA_MS_WAIT_TIME_CMD_ECHO,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_ECHO},
+  [STSAFEA_CMD_RESET]                 = {STSAFEA_MS_WAIT_TIME_CMD_RESET,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_RESET},
+  [STSAFEA_CMD_GENERATE_RANDOM]       = {STSAFEA_MS_WAIT_TIME_CMD_GENERATE_RANDOM,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_RANDOM},
+  [STSAFEA_CMD_START_SESSION]         = {STSAFEA_MS_WAIT_TIME_CMD_START_SESSION,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_START_SESSION},
+  [STSAFEA_CMD_DECREMENT]             = {STSAFEA_MS_WAIT_TIME_CMD_DECREMENT,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_DECREMENT},
+  [STSAFEA_CMD_READ]                  = {STSAFEA_MS_WAIT_TIME_CMD_READ,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_READ},
+  [STSAFEA_CMD_UPDATE]                = {STSAFEA_MS_WAIT_TIME_CMD_UPDATE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_UPDATE},
+  [STSAFEA_CMD_DELETE_KEY]            = {STSAFEA_MS_WAIT_TIME_CMD_DELETE_KEY,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_DELETE_KEY},
+  [STSAFEA_CMD_HIBERNATE]             = {STSAFEA_MS_WAIT_TIME_CMD_HIBERNATE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_HIBERNATE},
+  [STSAFEA_CMD_WRAP_LOCAL_ENVELOPE]   = {STSAFEA_MS_WAIT_TIME_CMD_WRAP_LOCAL_ENVELOPE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_WRAP_LOCAL_ENVELOPE},
+  [STSAFEA_CMD_UNWRAP_LOCAL_ENVELOPE] = {STSAFEA_MS_WAIT_TIME_CMD_UNWRAP_LOCAL_ENVELOPE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_UNWRAP_LOCAL_ENVELOPE},
+  [STSAFEA_CMD_PUT_ATTRIBUTE]         = {STSAFEA_MS_WAIT_TIME_CMD_PUT_ATTRIBUTE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_PUT_ATTRIBUTE},
+  [STSAFEA_CMD_GENERATE_KEY]          = {STSAFEA_MS_WAIT_TIME_CMD_GENERATE_KEY,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_KEY},
+  [STSAFEA_CMD_QUERY]                 = {STSAFEA_MS_WAIT_TIME_CMD_QUERY,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_QUERY},
+#if defined(STSAFE_A100)
+  [STSAFEA_CMD_GET_SIGNATURE]         = {STSAFEA_MS_WAIT_TIME_CMD_GET_SIGNATURE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_GET_SIGNATURE},
+#endif /* STSAFE_A100 */
+  [STSAFEA_CMD_GENERATE_SIGNATURE]    = {STSAFEA_MS_WAIT_TIME_CMD_GENERATE_SIGNATURE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_GENERATE_SIGNATURE},
+  [STSAFEA_CMD_VERIFY_SIGNATURE]      = {STSAFEA_MS_WAIT_TIME_CMD_VERIFY_MSG_SIGNATURE,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_MSG_SIGNATURE},
+  [STSAFEA_CMD_ESTABLISH_KEY]         = {STSAFEA_MS_WAIT_TIME_CMD_ESTABLISH_KEY,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_ESTABLISH_KEY},
+  [STSAFEA_CMD_VERIFY_PASSWORD]       = {STSAFEA_MS_WAIT_TIME_CMD_VERIFY_PASSWORD,
+                                         STSAFEA_MS_MIN_WAIT_TIME_CMD_VERIFY_PASSWORD},
+};
+
 /* Global variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
+static StSafeA_ResponseCode_t StSafeA_ExecuteCommand(StSafeA_Handle_t *pStSafeA, uint16_t RespDataLen, uint8_t InMAC);
+static StSafeA_ResponseCode_t StSafeA_ExchangeCommand(StSafeA_Handle_t *pStSafeA, uint16_t RespDataLen, uint8_t InMAC,
+                                                      uint32_t MsWaitTime, uint32_t MsMinWaitTime, uint8_t Learned);
 static StSafeA_ResponseCode_t StSafeA_TransmitCommand(StSafeA_Handle_t *pStSafeA);
-static StSafeA_ResponseCode_t StSafeA_ReceiveResponse(StSafeA_Handle_t *pStSafeA);
+static StSafeA_ResponseCode_t StSafeA_ReceiveResponse(StSafeA_Handle_t *pStSafeA, uint8_t Learned);
+static void StSafeA_WaitResponse(StSafeA_Handle_t *pStSafeA, uint32_t MsWaitTime, uint32_t MsMinWaitTime,
+                                 uint8_t Learned);
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+static uint32_t StSafeA_GetLearnedWaitTime(StSafeA_Handle_t *pStSafeA, uint32_t MsWaitTime, uint32_t MsMinWaitTime);
+static void StSafeA_UpdateLatencyModel(StSafeA_Handle_t *pStSafeA, uint8_t CommandCode);
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
 static StSafeA_ResponseCode_t StSafeA_AssignLVResponse(StSafeA_LVBuffer_t *pDestLVBuffer,
-                                                       StSafeA_LVBuffer_t *pSrcLVBuffer, uint16_t ExpectedLen);
+                                                       StSafeA_LVBuffer_t *pSrcLVBuffer, uint16_t ExpectedLen,
+                                                       uint8_t InPlace);
 static StSafeA_ResponseCode_t StSafeA_AssignLVBuffer(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pDataBuffer,
-                                                     uint16_t ExpectedLen);
-static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLVData, uint16_t Length);
+                                                     uint16_t ExpectedLen, uint8_t InPlace);
+static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLVData, uint16_t Length,
+                              uint8_t InPlace);
 static void StSafeA_BuildCommandHeaderCMAC(StSafeA_Handle_t *pStSafeA, uint8_t CommandCode, uint8_t *pMAC);
+static void StSafeA_CopyCommandData(StSafeA_Handle_t *pStSafeA, uint16_t Offset, const uint8_t *pData,
+                                    uint16_t Length);
 #if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
 static void StSafeA_GetHostMacSequenceCounter(StSafeA_Handle_t *pStSafeA);
+static void StSafeA_UpdateHostMacSequenceCounter(StSafeA_Handle_t *pStSafeA, uint8_t Header,
+                                                 StSafeA_ResponseCode_t StatusCode);
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
 StSafeA_ResponseCode_t StSafeA_Process_Update(StSafeA_Handle_t *pStSafeA, uint8_t InAtomicity,
                                               uint8_t InChangeACIndicator, uint8_t InNewUpdateACRight,
@@ -146,21 +234,49 @@ StSafeA_ResponseCode_t StSafeA_Process_Update(StSafeA_Handle_t *pStSafeA, uint8_
  ===============================================================================
 [..]
     (+) Init
+    (+) Init Device
+    (+) Get / Set Latency Model
+    (+) Set Retry Policy / Deadline / Buffer Size / In-place Responses
+    (+) Get / Reset Statistics
+    (+) Get / Reset Profile
+    (+) Read Trace
 @endverbatim
   * @{
   */
 
 /**
   * @brief   StSafeA_Init
-  *          Create, initialize and assign the STSAFE-A1xx device handle.
+  *          Create, initialize and assign the STSAFE-A1xx device handle, for the default device.
   * @note    No other APIs can be called/used if this one has never been called
   *
   * @param   pStSafeA : Handle pointer for STSAFE-A1xx interface to be properly initialized
   * @param   pAllocatedRxTxBufferData : Rx/Tx Buffer used to transmit/receive data to/from STSAFEA.
-  *          Memory for Rx/Tx buffer must be allocated before being passed to this function
+  *          Memory for Rx/Tx buffer must be allocated before being passed to this function,
+  *          with a size of STSAFEA_BUFFER_MAX_SIZE
   * @retval  STSAFEA_OK if success, an error code otherwise
   */
 StSafeA_ResponseCode_t StSafeA_Init(StSafeA_Handle_t *pStSafeA, uint8_t *pAllocatedRxTxBufferData)
+{
+  return StSafeA_InitDevice(pStSafeA, pAllocatedRxTxBufferData, NULL, 0U);
+}
+
+/**
+  * @brief   StSafeA_InitDevice
+  *          Create, initialize and assign the STSAFE-A1xx device handle, for the device at the given bus and
+  *          address. Each handle holds its own bus and MAC contexts, so that several devices can be used at the
+  *          same time, with a different handle and Rx/Tx buffer each.
+  * @note    No other APIs can be called/used if this one has never been called
+  *
+  * @param   pStSafeA : Handle pointer for STSAFE-A1xx interface to be properly initialized
+  * @param   pAllocatedRxTxBufferData : Rx/Tx Buffer used to transmit/receive data to/from STSAFEA.
+  *          Memory for Rx/Tx buffer must be allocated before being passed to this function,
+  *          with a size of STSAFEA_BUFFER_MAX_SIZE
+  * @param   pBusCtx : Bus context passed to the bus functions of StSafeA_HW_Probe, NULL for the default bus.
+  * @param   DevAddr : Device address on the bus, 0 for the default address.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_InitDevice(StSafeA_Handle_t *pStSafeA, uint8_t *pAllocatedRxTxBufferData,
+                                          void *pBusCtx, uint16_t DevAddr)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
 
@@ -172,16 +288,34 @@ StSafeA_ResponseCode_t StSafeA_Init(StSafeA_Handle_t *pStSafeA, uint8_t *pAlloca
     pStSafeA->CrcSupport    = STSAFEA_CRC_SUPPORT;
     pStSafeA->MacCounter    = 0;
     pStSafeA->InOutBuffer.LV.Length = 0;
-    pStSafeA->InOutBuffer.LV.Data   = pAllocatedRxTxBufferData;
+    /* Data starts after the headroom where the frame header is placed when transmitting/receiving */
+    pStSafeA->InOutBuffer.LV.Data   = &pAllocatedRxTxBufferData[STSAFEA_BUFFER_HEADROOM_SIZE];
     pStSafeA->HostMacSequenceCounter = STSAFEA_HOST_CMAC_INVALID_COUNTER;
+    pStSafeA->HostMacSequenceCounterPending = 0U;
+    pStSafeA->CommandCounter = 0U;
+    pStSafeA->InPlaceResponse = STSAFEA_FLAG_FALSE;
 
     pStSafeA->HashObj.HashType = STSAFEA_SHA_256;
     pStSafeA->HashObj.HashCtx = NULL;
     (void)memset(pStSafeA->HashObj.HashRes, 0, sizeof(pStSafeA->HashObj.HashRes));
 
+    (void)memset(&pStSafeA->RMacObj, 0, sizeof(pStSafeA->RMacObj));
+
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+    (void)memset(&pStSafeA->LatencyModel, 0, sizeof(pStSafeA->LatencyModel));
+    pStSafeA->WaitTime = 0;
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
+    (void)memset(&pStSafeA->HwCtx, 0, sizeof(pStSafeA->HwCtx));
+    pStSafeA->HwCtx.pBusCtx = pBusCtx;
+    pStSafeA->HwCtx.DevAddr = DevAddr;
+    pStSafeA->HwCtx.TxCrcLength = STSAFEA_CRC_NOT_ACCUMULATED;
+    pStSafeA->HwCtx.TimeLeft = STSAFEA_NO_DEADLINE;
+    pStSafeA->HwCtx.BufferPacketSize = STSAFEA_BUFFER_DATA_PACKET_SIZE;
+
     status_code = STSAFEA_UNEXPECTED_ERROR;
     /* Initialize the Board Support Package */
-    if (StSafeA_HW_Init() == 0)
+    if (StSafeA_HW_Init(&pStSafeA->HwCtx) == 0)
     {
       /* Initialize/Retrieve the Host MAC and Cipher Keys  */
       if (StSafeA_HostKeys_Init() == 0)
@@ -194,6 +328,311 @@ StSafeA_ResponseCode_t StSafeA_Init(StSafeA_Handle_t *pStSafeA, uint8_t *pAlloca
   return status_code;
 }
 
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+/**
+  * @brief   StSafeA_GetLatencyModel
+  *          Retrieve the command processing times learned since StSafeA_Init, so that the application can
+  *          store them and preload them at next boot.
+  *
+  * @param   pStSafeA         : STSAFE-A1xx object pointer.
+  * @param   pOutLatencyModel : StSafeA_LatencyModel_t structure pointer to be filled with the learned times.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_GetLatencyModel(StSafeA_Handle_t *pStSafeA, StSafeA_LatencyModel_t *pOutLatencyModel)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && (pOutLatencyModel != NULL))
+  {
+    (void)memcpy(pOutLatencyModel, &pStSafeA->LatencyModel, sizeof(StSafeA_LatencyModel_t));
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_SetLatencyModel
+  *          Preload command processing times learned during a previous session.
+  * @note    Must be called after StSafeA_Init. The model must have been retrieved with StSafeA_GetLatencyModel
+  *          from a Middleware built with the same STSAFEA_LATENCY_MODEL_BIN_NUMBER.
+  *
+  * @param   pStSafeA        : STSAFE-A1xx object pointer.
+  * @param   pInLatencyModel : StSafeA_LatencyModel_t structure pointer to the times to preload.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_SetLatencyModel(StSafeA_Handle_t *pStSafeA,
+                                               const StSafeA_LatencyModel_t *pInLatencyModel)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && (pInLatencyModel != NULL))
+  {
+    (void)memcpy(&pStSafeA->LatencyModel, pInLatencyModel, sizeof(StSafeA_LatencyModel_t));
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
+/**
+  * @brief   StSafeA_SetRetryPolicy
+  *          Select how the command sending and the response reading are retried while the STSAFE-A1xx device is
+  *          busy and NACKs them.
+  *
+  * @param   pStSafeA       : STSAFE-A1xx object pointer.
+  * @param   pInRetryPolicy : StSafeA_RetryPolicy_t structure pointer to the policy, NULL for the default policy.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_SetRetryPolicy(StSafeA_Handle_t *pStSafeA,
+                                              const StSafeA_RetryPolicy_t *pInRetryPolicy)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
+  {
+    if (pInRetryPolicy != NULL)
+    {
+      (void)memcpy(&pStSafeA->HwCtx.RetryPolicy, pInRetryPolicy, sizeof(StSafeA_RetryPolicy_t));
+    }
+    else
+    {
+      (void)memset(&pStSafeA->HwCtx.RetryPolicy, 0, sizeof(StSafeA_RetryPolicy_t));
+    }
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_SetDeadline
+  *          Bound the time each following command spends waiting for the STSAFE-A1xx device: processing time and
+  *          bus retries. A command reaching its deadline returns STSAFEA_COMMUNICATION_TIMEOUT.
+  * @note    The time is measured with the TimeGetUs function of the bus layer when provided. Otherwise it is
+  *          accounted from the delays requested to the bus layer, the bus transfers themselves not being included.
+  *          The Host C-MAC sequence counter query a command may need has its own deadline.
+  *
+  * @param   pStSafeA   : STSAFE-A1xx object pointer.
+  * @param   MsDeadline : Maximum waiting time in ms, 0 for no deadline.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_SetDeadline(StSafeA_Handle_t *pStSafeA, uint32_t MsDeadline)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
+  {
+    pStSafeA->HwCtx.Deadline = MsDeadline;
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_SetBufferSize
+  *          Declare the size of the Rx/Tx buffer given to StSafeA_InitDevice, when it is smaller than
+  *          STSAFEA_BUFFER_MAX_SIZE. Commands and responses longer than the buffer holds then return
+  *          STSAFEA_BUFFER_LENGTH_EXCEEDED.
+  * @note    STSAFEA_BUFFER_SIZE gives the buffer size for a maximum data size, which must be at least
+  *          STSAFEA_BUFFER_MIN_DATA_SIZE.
+  *
+  * @param   pStSafeA   : STSAFE-A1xx object pointer.
+  * @param   BufferSize : Size in bytes of the Rx/Tx buffer, from STSAFEA_BUFFER_SIZE(STSAFEA_BUFFER_MIN_DATA_SIZE)
+  *                       to STSAFEA_BUFFER_MAX_SIZE.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_SetBufferSize(StSafeA_Handle_t *pStSafeA, uint16_t BufferSize)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers and parameters */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) &&
+      (BufferSize >= STSAFEA_BUFFER_SIZE(STSAFEA_BUFFER_MIN_DATA_SIZE)) &&
+      (BufferSize <= STSAFEA_BUFFER_MAX_SIZE))
+  {
+    pStSafeA->HwCtx.BufferPacketSize = BufferSize - STSAFEA_BUFFER_DATA_EXTENSION_SIZE;
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_SetInPlaceResponse
+  *          Select whether the output LV buffers given with a NULL Data are rejected, or given a pointer to the
+  *          response data inside the Rx/Tx buffer instead of a copy, as with STSAFEA_USE_OPTIMIZATION_SHARED_RAM.
+  * @note    The pointed data is overwritten by the next command, which increments pStSafeA->CommandCounter.
+  *          Output LV buffers with a non NULL Data are still copied to.
+  *
+  * @param   pStSafeA        : STSAFE-A1xx object pointer.
+  * @param   InPlaceResponse : STSAFEA_FLAG_TRUE to point inside the Rx/Tx buffer, STSAFEA_FLAG_FALSE (default) to
+  *                            reject a NULL Data.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_SetInPlaceResponse(StSafeA_Handle_t *pStSafeA, uint8_t InPlaceResponse)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers and parameters */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && IS_STSAFEA_FLAG(InPlaceResponse))
+  {
+    pStSafeA->InPlaceResponse = InPlaceResponse;
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+#if (STSAFEA_USE_STATISTICS)
+/**
+  * @brief   StSafeA_GetStatistics
+  *          Retrieve the communication counters of the STSAFE-A1xx device since StSafeA_Init or the last
+  *          StSafeA_ResetStatistics, per command code and for all the commands.
+  * @note    Must be called from the thread sending the commands, the counters are not updated atomically.
+  *
+  * @param   pStSafeA       : STSAFE-A1xx object pointer.
+  * @param   pOutStatistics : StSafeA_Statistics_t structure pointer to be filled with the counters.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_GetStatistics(StSafeA_Handle_t *pStSafeA, StSafeA_Statistics_t *pOutStatistics)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+  StSafeA_CommandStatistics_t *p_total;
+  uint8_t i;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && (pOutStatistics != NULL))
+  {
+    (void)memcpy(pOutStatistics->Cmd, pStSafeA->HwCtx.Stats, sizeof(pOutStatistics->Cmd));
+
+    p_total = &pOutStatistics->Total;
+    (void)memset(p_total, 0, sizeof(StSafeA_CommandStatistics_t));
+    for (i = 0; i < STSAFEA_CMD_CODE_NUMBER; i++)
+    {
+      p_total->Commands      += pOutStatistics->Cmd[i].Commands;
+      p_total->NackRetries   += pOutStatistics->Cmd[i].NackRetries;
+      p_total->CrcErrors     += pOutStatistics->Cmd[i].CrcErrors;
+      p_total->ReReads       += pOutStatistics->Cmd[i].ReReads;
+      p_total->BytesSent     += pOutStatistics->Cmd[i].BytesSent;
+      p_total->BytesReceived += pOutStatistics->Cmd[i].BytesReceived;
+      p_total->WaitTime      += pOutStatistics->Cmd[i].WaitTime;
+    }
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_ResetStatistics
+  *          Clear the communication counters of the STSAFE-A1xx device.
+  *
+  * @param   pStSafeA : STSAFE-A1xx object pointer.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_ResetStatistics(StSafeA_Handle_t *pStSafeA)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
+  {
+    (void)memset(pStSafeA->HwCtx.Stats, 0, sizeof(pStSafeA->HwCtx.Stats));
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+#endif /* STSAFEA_USE_STATISTICS */
+
+#if (STSAFEA_USE_PROFILING)
+/**
+  * @brief   StSafeA_GetProfile
+  *          Retrieve the host processing time spent by the Middleware in its CRC, command copy, MAC and encryption
+  *          code for the STSAFE-A1xx device since StSafeA_Init or the last StSafeA_ResetProfile.
+  * @note    Must be called from the thread sending the commands, the counters are not updated atomically.
+  *
+  * @param   pStSafeA    : STSAFE-A1xx object pointer.
+  * @param   pOutProfile : StSafeA_Profile_t structure pointer to be filled with the counters.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_GetProfile(StSafeA_Handle_t *pStSafeA, StSafeA_Profile_t *pOutProfile)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && (pOutProfile != NULL))
+  {
+    (void)memcpy(pOutProfile, &pStSafeA->HwCtx.Profile, sizeof(StSafeA_Profile_t));
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+
+/**
+  * @brief   StSafeA_ResetProfile
+  *          Clear the host processing time counters of the STSAFE-A1xx device.
+  *
+  * @param   pStSafeA : STSAFE-A1xx object pointer.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_ResetProfile(StSafeA_Handle_t *pStSafeA)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
+  {
+    (void)memset(&pStSafeA->HwCtx.Profile, 0, sizeof(StSafeA_Profile_t));
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+#endif /* STSAFEA_USE_PROFILING */
+
+#if (STSAFEA_USE_TRACE)
+/**
+  * @brief   StSafeA_ReadTrace
+  *          Move the oldest command phases out of the trace of the STSAFE-A1xx device, see StSafeA_TracePhase_t.
+  * @note    Can be called from another thread than the one sending the commands, without lock, but from a single
+  *          thread at a time. Phases recorded while the trace is full are dropped.
+  *
+  * @param   pStSafeA    : STSAFE-A1xx object pointer.
+  * @param   pOutEntries : Array to be filled with the trace entries, oldest first.
+  * @param   InMaxNumber : Size of the pOutEntries array.
+  * @param   pOutNumber  : Number of entries read.
+  * @param   pOutDropped : Number of entries dropped since StSafeA_Init, NULL if not needed.
+  * @retval  STSAFEA_OK if success, an error code otherwise
+  */
+StSafeA_ResponseCode_t StSafeA_ReadTrace(StSafeA_Handle_t *pStSafeA, StSafeA_TraceEntry_t *pOutEntries,
+                                         uint16_t InMaxNumber, uint16_t *pOutNumber, uint32_t *pOutDropped)
+{
+  StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+
+  /* Check null pointers */
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA) && (pOutEntries != NULL) && (pOutNumber != NULL))
+  {
+    *pOutNumber = StSafeA_TraceRead(&pStSafeA->HwCtx, pOutEntries, InMaxNumber);
+    if (pOutDropped != NULL)
+    {
+      *pOutDropped = pStSafeA->HwCtx.Trace.Dropped;
+    }
+    status_code = STSAFEA_OK;
+  }
+
+  return status_code;
+}
+#endif /* STSAFEA_USE_TRACE */
+
 /**
   * @}
   */
@@ -270,27 +709,17 @@ StSafeA_ResponseCode_t StSafeA_Echo(
     StSafeA_BuildCommandHeaderCMAC(pStSafeA, STSAFEA_CMD_ECHO, &InMAC);
 
     /* Build command Data */
-    STSAFEA_CHECK_SIZE(InMAC, 0U, InRespDataLen);
-    (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[0], pInEchoData, InRespDataLen);
+    STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 0U, InRespDataLen);
+    StSafeA_CopyCommandData(pStSafeA, 0U, pInEchoData, InRespDataLen);
     pStSafeA->InOutBuffer.LV.Length = InRespDataLen;
 
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, InRespDataLen, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = InRespDataLen + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_ECHO);
-
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        /* Assign the received response to the output parameter */
-        status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen);
-      }
+      /* Assign the received response to the output parameter */
+      status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen,
+                                             pStSafeA->InPlaceResponse);
     }
   }
 
@@ -322,21 +751,11 @@ StSafeA_ResponseCode_t StSafeA_Reset(
 
     pStSafeA->InOutBuffer.LV.Length = 0U;
 
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_RESET);
-
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-      if (status_code == STSAFEA_OK)
-      {
-        pStSafeA->MacCounter = 0;
-      }
+      pStSafeA->MacCounter = 0;
     }
   }
 
@@ -406,29 +825,19 @@ StSafeA_ResponseCode_t StSafeA_GenerateRandom(
     pStSafeA->InOutBuffer.LV.Length = 2U;
 #endif /* STSAFE_A100 */
 
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
-    {
 #if defined(STSAFE_A100)
-      tmp_len = (InRndSubject == STSAFEA_EPHEMERAL_RND) ? InRespDataLen : STSAFEA_RANDOM_ENTITY_AUTH_RESPONSE_LENGTH;
+    tmp_len = (InRndSubject == STSAFEA_EPHEMERAL_RND) ? InRespDataLen : STSAFEA_RANDOM_ENTITY_AUTH_RESPONSE_LENGTH;
 #else
-      tmp_len = InRespDataLen;
+    tmp_len = InRespDataLen;
 #endif /* STSAFE_A100 */
 
-      tmp_len += STSAFEA_R_MAC_LENGTH(InMAC);
-      pStSafeA->InOutBuffer.LV.Length = tmp_len;
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_GENERATE_RANDOM);
-
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, tmp_len, InMAC);
 
-      if (status_code == STSAFEA_OK)
-      {
-        /* Assign the received response to the output parameter */
-        status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen);
-      }
+    if (status_code == STSAFEA_OK)
+    {
+      /* Assign the received response to the output parameter */
+      status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen,
+                                             pStSafeA->InPlaceResponse);
     }
   }
 
@@ -468,19 +877,7 @@ StSafeA_ResponseCode_t StSafeA_Hibernate(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)InWakeUpMode;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
-    {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_HIBERNATE);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-    }
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
   }
   return status_code;
 }
@@ -551,87 +948,75 @@ StSafeA_ResponseCode_t StSafeA_DataPartitionQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_DATA_PARTITION_CONFIGURATION;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_DATA_PARTITION_QUERY_MIN_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_DATA_PARTITION_QUERY_MIN_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutDataPartition->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutDataPartition->NumberOfZones = pStSafeA->InOutBuffer.LV.Data[0];
+      pOutDataPartition->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutDataPartition->NumberOfZones = pStSafeA->InOutBuffer.LV.Data[0];
 #if (STSAFEA_USE_OPTIMIZATION_SHARED_RAM)
-        (void)InZoneMaxNum;
-        pOutDataPartition->pZoneInfoRecord = (StSafeA_ZoneInformationRecordBuffer_t *)&pStSafeA->InOutBuffer.LV.Data[1];
+      (void)InZoneMaxNum;
+      pOutDataPartition->pZoneInfoRecord = (StSafeA_ZoneInformationRecordBuffer_t *)&pStSafeA->InOutBuffer.LV.Data[1];
 #else
-        if (pOutDataPartition->NumberOfZones > InZoneMaxNum)
-        {
-          /* Return an error so the application can read the correct number of zones,
-             allocate the right space (if not under STSAFEA_USE_OPTIMIZATION_SHARED_RAM optimization),
-             and call back this API with the right InZoneMaxNum parameter */
-          return STSAFEA_INVALID_RESP_LENGTH;
-        }
+      if (pOutDataPartition->NumberOfZones > InZoneMaxNum)
+      {
+        /* Return an error so the application can read the correct number of zones,
+           allocate the right space (if not under STSAFEA_USE_OPTIMIZATION_SHARED_RAM optimization),
+           and call back this API with the right InZoneMaxNum parameter */
+        return STSAFEA_INVALID_RESP_LENGTH;
+      }
 
-        (void)memcpy(pOutDataPartition->pZoneInfoRecord,
-                     &pStSafeA->InOutBuffer.LV.Data[1],
-                     (uint32_t)pOutDataPartition->Length - 1U);
+      (void)memcpy(pOutDataPartition->pZoneInfoRecord,
+                   &pStSafeA->InOutBuffer.LV.Data[1],
+                   (uint32_t)pOutDataPartition->Length - 1U);
 #endif /* STSAFEA_USE_OPTIMIZATION_SHARED_RAM */
-        uint16_t uIdx;
-        for (uint8_t i = 0; i < pOutDataPartition->NumberOfZones; i++)
+      uint16_t uIdx;
+      for (uint8_t i = 0; i < pOutDataPartition->NumberOfZones; i++)
+      {
+        uIdx = (uint16_t)(i * sizeof(StSafeA_ZoneInformationRecordBuffer_t)) + 1U;
+        if (pOutDataPartition->pZoneInfoRecord[i].ZoneType == STSAFEA_ONE_WAY_COUNTER_PRESENCE)
         {
-          uIdx = (uint16_t)(i * sizeof(StSafeA_ZoneInformationRecordBuffer_t)) + 1U;
-          if (pOutDataPartition->pZoneInfoRecord[i].ZoneType == STSAFEA_ONE_WAY_COUNTER_PRESENCE)
-          {
-            (void)memmove(&pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition + 3U,
-                          &pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition,
-                          (uint32_t)pOutDataPartition->Length - uIdx - 3U);
-            /* Add bytes for AC */
-            pOutDataPartition->Length += 3U;
-            /* Adjust little/big endian bytes */
-            pOutDataPartition->pZoneInfoRecord[i].OneWayCounter =
-              SWAP4BYTES(pOutDataPartition->pZoneInfoRecord[i].OneWayCounter);
-          }
-          else
+          (void)memmove(&pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition + 3U,
+                        &pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition,
+                        (uint32_t)pOutDataPartition->Length - uIdx - 3U);
+          /* Add bytes for AC */
+          pOutDataPartition->Length += 3U;
+          /* Adjust little/big endian bytes */
+          pOutDataPartition->pZoneInfoRecord[i].OneWayCounter =
+            SWAP4BYTES(pOutDataPartition->pZoneInfoRecord[i].OneWayCounter);
+        }
+        else
+        {
+          if ((i + 1U) < pOutDataPartition->NumberOfZones)
           {
-            if ((i + 1U) < pOutDataPartition->NumberOfZones)
-            {
-              (void)memmove(&pOutDataPartition->pZoneInfoRecord[i + 1U].Index,
-                            &pOutDataPartition->pZoneInfoRecord[i].UpdateAccessCondition,
-                            (uint32_t)pOutDataPartition->Length - uIdx - 5U);
+            (void)memmove(&pOutDataPartition->pZoneInfoRecord[i + 1U].Index,
+                          &pOutDataPartition->pZoneInfoRecord[i].UpdateAccessCondition,
+                          (uint32_t)pOutDataPartition->Length - uIdx - 5U);
 
-              /* Add bytes for AC & counter */
-              pOutDataPartition->Length += 7U;
-            }
-            /* One way counter set to 0 */
-            pOutDataPartition->pZoneInfoRecord[i].OneWayCounter = 0;
-            /* Copy data segment length */
-            pOutDataPartition->pZoneInfoRecord[i].DataSegmentLength =
-              pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition +
-              ((uint16_t)pOutDataPartition->pZoneInfoRecord[i].UpdateAcChangeRight << 8U);
+            /* Add bytes for AC & counter */
+            pOutDataPartition->Length += 7U;
           }
-          /* Adjust little/big endian bytes */
+          /* One way counter set to 0 */
+          pOutDataPartition->pZoneInfoRecord[i].OneWayCounter = 0;
+          /* Copy data segment length */
           pOutDataPartition->pZoneInfoRecord[i].DataSegmentLength =
-            (uint16_t)SWAP2BYTES(pOutDataPartition->pZoneInfoRecord[i].DataSegmentLength);
-
-          /* Adjust AC bytes */
-          pOutDataPartition->pZoneInfoRecord[i].UpdateAccessCondition =
-            pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X07U;
-          pOutDataPartition->pZoneInfoRecord[i].UpdateAcChangeRight   =
-            (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X08U) >> 3;
-          pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition   =
-            (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X70U) >> 4;
-          pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight     =
-            (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X80U) >> 7;
+            pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition +
+            ((uint16_t)pOutDataPartition->pZoneInfoRecord[i].UpdateAcChangeRight << 8U);
         }
+        /* Adjust little/big endian bytes */
+        pOutDataPartition->pZoneInfoRecord[i].DataSegmentLength =
+          (uint16_t)SWAP2BYTES(pOutDataPartition->pZoneInfoRecord[i].DataSegmentLength);
+
+        /* Adjust AC bytes */
+        pOutDataPartition->pZoneInfoRecord[i].UpdateAccessCondition =
+          pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X07U;
+        pOutDataPartition->pZoneInfoRecord[i].UpdateAcChangeRight   =
+          (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X08U) >> 3;
+        pOutDataPartition->pZoneInfoRecord[i].ReadAccessCondition   =
+          (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X70U) >> 4;
+        pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight     =
+          (pOutDataPartition->pZoneInfoRecord[i].ReadAcChangeRight & 0X80U) >> 7;
       }
     }
   }
@@ -719,35 +1104,23 @@ StSafeA_ResponseCode_t StSafeA_Decrement(
     /* Data */
     if ((pInData != NULL) && (pInData->Length > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length, pInData->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length],
-                   pInData->Data,
-                   pInData->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length, pInData->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length,
+                              pInData->Data,
+                              pInData->Length);
 
       pStSafeA->InOutBuffer.LV.Length += pInData->Length;
     }
 
     /* Transmit command */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_DECREMENT_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_DECREMENT_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_DECREMENT);
-
-      /* Read response */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutDecrement->Length = pStSafeA->InOutBuffer.LV.Length;
-        (void)memcpy((uint8_t *)&pOutDecrement->OneWayCounter, pStSafeA->InOutBuffer.LV.Data,
-                     sizeof(pOutDecrement->OneWayCounter));
-        pOutDecrement->OneWayCounter = (uint32_t)SWAP4BYTES(pOutDecrement->OneWayCounter);
-      }
+      pOutDecrement->Length = pStSafeA->InOutBuffer.LV.Length;
+      (void)memcpy((uint8_t *)&pOutDecrement->OneWayCounter, pStSafeA->InOutBuffer.LV.Data,
+                   sizeof(pOutDecrement->OneWayCounter));
+      pOutDecrement->OneWayCounter = (uint32_t)SWAP4BYTES(pOutDecrement->OneWayCounter);
     }
   }
   return status_code;
@@ -814,7 +1187,7 @@ StSafeA_ResponseCode_t StSafeA_Read(
 
     /* Build command Header and process CMAC */
 
-    STSAFEA_CHECK_SIZE(STSAFEA_MAC_NONE, 0U, InRespDataLen);
+    STSAFEA_CHECK_SIZE(pStSafeA, STSAFEA_MAC_NONE, 0U, InRespDataLen);
 
     StSafeA_BuildCommandHeaderCMAC(pStSafeA, STSAFEA_CMD_READ, &InMAC);
 
@@ -835,23 +1208,13 @@ StSafeA_ResponseCode_t StSafeA_Read(
     pStSafeA->InOutBuffer.LV.Length = 6U;
 
     /* Transmit command */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, InRespDataLen, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = InRespDataLen + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_READ);
-
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        /* Assign the received response to the output parameter */
-        status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen);
-      }
+      /* Assign the received response to the output parameter */
+      status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InRespDataLen,
+                                             pStSafeA->InPlaceResponse);
     }
   }
   return status_code;
@@ -932,27 +1295,16 @@ StSafeA_ResponseCode_t StSafeA_Process_Update(
     /* Data */
     if ((pInLVData != NULL) && (pInLVData->Length > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length, pInLVData->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length],
-                   pInLVData->Data,
-                   pInLVData->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length, pInLVData->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length,
+                              pInLVData->Data,
+                              pInLVData->Length);
 
       pStSafeA->InOutBuffer.LV.Length += pInLVData->Length;
     }
 
     /* Transmit command */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
-    {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_UPDATE);
-
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-    }
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
   }
 
   return status_code;
@@ -1117,9 +1469,9 @@ StSafeA_ResponseCode_t StSafeA_GenerateKeyPair(
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
 
   /* Check null pointers */
-  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)              &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutPubX) &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutPubY) &&
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)                   &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutPubX) &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutPubY) &&
       (pOutPointReprensentationId != NULL))
   {
     /* Check parameters */
@@ -1172,50 +1524,39 @@ StSafeA_ResponseCode_t StSafeA_GenerateKeyPair(
     pStSafeA->InOutBuffer.LV.Length = tmp_len;
 
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA,
+                                         STSAFEA_POINT_REPRESENTATION_ID_LEN + 2U * (STSAFEA_LENGTH_SIZE + (uint16_t)STSAFEA_GET_XYRS_LEN_FROM_CURVE(InCurveId)),
+                                         InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_POINT_REPRESENTATION_ID_LEN +
-                                        2U * (STSAFEA_LENGTH_SIZE +
-                                              (uint16_t)STSAFEA_GET_XYRS_LEN_FROM_CURVE(InCurveId)) +
-                                        STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_GENERATE_KEY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
+      status_code = STSAFEA_INVALID_RESP_LENGTH;
+      if (STSAFEA_GET_XYRS_LEN_FROM_CURVE(InCurveId) <= InPubXYLen)
       {
-        status_code = STSAFEA_INVALID_RESP_LENGTH;
-        if (STSAFEA_GET_XYRS_LEN_FROM_CURVE(InCurveId) <= InPubXYLen)
+        uint16_t uIdx = 1U;
+        /* Assign Representation Id */
+        if (pStSafeA->InOutBuffer.LV.Length >= uIdx)
         {
-          uint16_t uIdx = 1U;
-          /* Assign Representation Id */
-          if (pStSafeA->InOutBuffer.LV.Length >= uIdx)
-          {
-            *pOutPointReprensentationId = pStSafeA->InOutBuffer.LV.Data[0];
-          }
+          *pOutPointReprensentationId = pStSafeA->InOutBuffer.LV.Data[0];
+        }
 
-          /* Assign Key X */
-          if (pStSafeA->InOutBuffer.LV.Length > (uIdx + sizeof(pOutPubX->Length)))
-          {
-            /* Assign the received response to the output parameter */
-            status_code = StSafeA_AssignLVBuffer(pOutPubX, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen);
+        /* Assign Key X */
+        if (pStSafeA->InOutBuffer.LV.Length > (uIdx + sizeof(pOutPubX->Length)))
+        {
+          /* Assign the received response to the output parameter */
+          status_code = StSafeA_AssignLVBuffer(pOutPubX, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen,
+                                               pStSafeA->InPlaceResponse);
 
-            uIdx += (uint16_t)sizeof(pOutPubX->Length) + pOutPubX->Length ;
-          }
+          uIdx += (uint16_t)sizeof(pOutPubX->Length) + pOutPubX->Length ;
+        }
 
-          /* Assign Key Y*/
-          if ((pStSafeA->InOutBuffer.LV.Length > (uIdx + sizeof(pOutPubY->Length))) && (status_code == STSAFEA_OK))
-          {
-            /* Assign the received response to the output parameter */
-            status_code = StSafeA_AssignLVBuffer(pOutPubY, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen);
-          }
+        /* Assign Key Y*/
+        if ((pStSafeA->InOutBuffer.LV.Length > (uIdx + sizeof(pOutPubY->Length))) && (status_code == STSAFEA_OK))
+        {
+          /* Assign the received response to the output parameter */
+          status_code = StSafeA_AssignLVBuffer(pOutPubY, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen,
+                                               pStSafeA->InPlaceResponse);
         }
       }
     }
@@ -1281,10 +1622,10 @@ StSafeA_ResponseCode_t StSafeA_GenerateSignature(
 #endif /* STSAFE_A100 */
 
   /* Check null pointers */
-  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)                &&
-      IS_STSAFEA_CONDITIONAL_VALID_PTR(pInDigest)           &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutSignR)  &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutSignS))
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)                    &&
+      IS_STSAFEA_CONDITIONAL_VALID_PTR(pInDigest)               &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutSignR) &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutSignS))
   {
     /* Check parameters */
     stsafea_assert_param(IS_STSAFEA_MAC(InMAC));
@@ -1318,13 +1659,13 @@ StSafeA_ResponseCode_t StSafeA_GenerateSignature(
       return STSAFEA_INVALID_PARAMETER;
     }
 
-    (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[3],
-                 pInDigest,
-                 DigestLength);
+    StSafeA_CopyCommandData(pStSafeA, 3U,
+                            pInDigest,
+                            DigestLength);
 #else
-    (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[3],
-                 pInDigest,
-                 ((InDigestType == STSAFEA_SHA_384) ? STSAFEA_SHA_384_LENGTH : STSAFEA_SHA_256_LENGTH));
+    StSafeA_CopyCommandData(pStSafeA, 3U,
+                            pInDigest,
+                            ((InDigestType == STSAFEA_SHA_384) ? STSAFEA_SHA_384_LENGTH : STSAFEA_SHA_256_LENGTH));
 #endif /* WORKAROUND_GENERATE_SIGNATURE */
 
     /* Length */
@@ -1347,46 +1688,36 @@ StSafeA_ResponseCode_t StSafeA_GenerateSignature(
 #endif /* STSAFE_A110 */
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
     {
-      /* Transmit command */
-      status_code = StSafeA_TransmitCommand(pStSafeA);
+      uint16_t tmp_len = (InDigestType == STSAFEA_SHA_384) ? STSAFEA_LENGTH_CMD_RESP_GENERATE_SIGNATURE_SHA_384 :
+                         STSAFEA_LENGTH_CMD_RESP_GENERATE_SIGNATURE_SHA_256;
+
+      /* Execute command */
+      status_code = StSafeA_ExecuteCommand(pStSafeA, tmp_len, InMAC);
 
       if (status_code == STSAFEA_OK)
       {
-        uint16_t tmp_len = (InDigestType == STSAFEA_SHA_384) ? STSAFEA_LENGTH_CMD_RESP_GENERATE_SIGNATURE_SHA_384 :
-                           STSAFEA_LENGTH_CMD_RESP_GENERATE_SIGNATURE_SHA_256;
-        /* Set response length */
-        pStSafeA->InOutBuffer.LV.Length = tmp_len + STSAFEA_R_MAC_LENGTH(InMAC); ;
-
-        /* Wait for the command processing. Then check for the response */
-        StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_GENERATE_SIGNATURE);
-
-        /* Read response */
-        status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-        if (status_code == STSAFEA_OK)
-        {
 #if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
 #if defined(STSAFE_A110)
-          /* Decrypt data */
-          if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) ==
-              (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
-          {
-            status_code = StSafeA_DataDecryption(pStSafeA);
-          }
+        /* Decrypt data */
+        if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) ==
+            (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
+        {
+          status_code = StSafeA_DataDecryption(pStSafeA);
+        }
 
-          if (status_code == STSAFEA_OK)
+        if (status_code == STSAFEA_OK)
 #endif /* STSAFE_A110 */
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
+        {
+          /* Assign the received response to the output parameter */
+          status_code = StSafeA_AssignLVBuffer(pOutSignR, &pStSafeA->InOutBuffer.LV.Data[0], InSignRSLen,
+                                               pStSafeA->InPlaceResponse);
+          if (status_code == STSAFEA_OK)
           {
-            /* Assign the received response to the output parameter */
-            status_code = StSafeA_AssignLVBuffer(pOutSignR, &pStSafeA->InOutBuffer.LV.Data[0], InSignRSLen);
-            if (status_code == STSAFEA_OK)
-            {
-              status_code = StSafeA_AssignLVBuffer(
-                              pOutSignS,
-                              &pStSafeA->InOutBuffer.LV.Data[STSAFEA_LENGTH_SIZE + pOutSignR->Length],
-                              InSignRSLen);
-            }
+            status_code = StSafeA_AssignLVBuffer(
+                            pOutSignS,
+                            &pStSafeA->InOutBuffer.LV.Data[STSAFEA_LENGTH_SIZE + pOutSignR->Length],
+                            InSignRSLen, pStSafeA->InPlaceResponse);
           }
         }
       }
@@ -1466,10 +1797,10 @@ StSafeA_ResponseCode_t StSafeA_VerifyMessageSignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubX->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubX->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubX->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubX->Data,
-                   pInPubX->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubX->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubX->Data,
+                              pInPubX->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubX->Length) + pInPubX->Length;
     }
@@ -1480,10 +1811,10 @@ StSafeA_ResponseCode_t StSafeA_VerifyMessageSignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubY->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubY->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubY->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubY->Data,
-                   pInPubY->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubY->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubY->Data,
+                              pInPubY->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubY->Length) + pInPubY->Length;
     }
@@ -1494,10 +1825,10 @@ StSafeA_ResponseCode_t StSafeA_VerifyMessageSignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInSignR->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInSignR->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSignR->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInSignR->Data,
-                   pInSignR->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSignR->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInSignR->Data,
+                              pInSignR->Length);
 
       pStSafeA->InOutBuffer.LV.Length += 2U + pInSignR->Length;
     }
@@ -1507,10 +1838,10 @@ StSafeA_ResponseCode_t StSafeA_VerifyMessageSignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInSignS->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInSignS->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSignS->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInSignS->Data,
-                   pInSignS->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSignS->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInSignS->Data,
+                              pInSignS->Length);
 
       pStSafeA->InOutBuffer.LV.Length += 2U + pInSignS->Length;
     }
@@ -1523,33 +1854,21 @@ StSafeA_ResponseCode_t StSafeA_VerifyMessageSignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInDigest->Length & 0x00FFU);
 
       /* Digest */
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInDigest->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInDigest->Data,
-                   pInDigest->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInDigest->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInDigest->Data,
+                              pInDigest->Length);
 
       pStSafeA->InOutBuffer.LV.Length += 2U + pInDigest->Length;
     }
 
     /* Transmit command */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_VERIFY_MSG_SIGNATURE_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_VERIFY_MSG_SIGNATURE_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_VERIFY_MSG_SIGNATURE);
-
-      /* Read response */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutRespVerifySignature->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutRespVerifySignature->SignatureValidity = pStSafeA->InOutBuffer.LV.Data[0];
-      }
+      pOutRespVerifySignature->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutRespVerifySignature->SignatureValidity = pStSafeA->InOutBuffer.LV.Data[0];
     }
   }
 
@@ -1628,13 +1947,13 @@ StSafeA_ResponseCode_t StSafeA_EstablishKey(
     /* X public key */
     if ((pInPubX->Length > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length, pInPubX->Length + STSAFEA_LENGTH_SIZE);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length, pInPubX->Length + STSAFEA_LENGTH_SIZE);
 
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubX->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubX->Length & 0x00FFU);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubX->Data,
-                   (uint32_t)pInPubX->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubX->Data,
+                              pInPubX->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubX->Length) + pInPubX->Length;
     }
@@ -1642,13 +1961,13 @@ StSafeA_ResponseCode_t StSafeA_EstablishKey(
     /* Y public key */
     if ((pInPubY->Length > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length, pInPubY->Length + STSAFEA_LENGTH_SIZE);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length, pInPubY->Length + STSAFEA_LENGTH_SIZE);
 
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubY->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubY->Length & 0x00FFU);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubY->Data,
-                   (uint32_t)pInPubY->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubY->Data,
+                              pInPubY->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubY->Length) + pInPubY->Length;
     }
@@ -1670,46 +1989,32 @@ StSafeA_ResponseCode_t StSafeA_EstablishKey(
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
     {
       /* Transmit command */
-      status_code = StSafeA_TransmitCommand(pStSafeA);
+      status_code = StSafeA_ExecuteCommand(pStSafeA, InSharedSecretLength + STSAFEA_LENGTH_SIZE, InMAC);
 
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
       if (status_code == STSAFEA_OK)
       {
-        /* Set response length */
-        pStSafeA->InOutBuffer.LV.Length = InSharedSecretLength +
-                                          STSAFEA_LENGTH_SIZE +
-                                          STSAFEA_R_MAC_LENGTH(InMAC);
-
-        /* Wait for the command processing. Then check for the response */
-        StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_ESTABLISH_KEY);
-
-        /* Read response */
-        status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
-        if (status_code == STSAFEA_OK)
-        {
 #if defined(STSAFE_A100)
-          status_code = StSafeA_DataDecryption(pStSafeA);
+        status_code = StSafeA_DataDecryption(pStSafeA);
 #else
-          /* Decrypt data */
-          if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) ==
-              (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
-          {
-            status_code = StSafeA_DataDecryption(pStSafeA);
-          }
-#endif /* STSAFE_A100 */
+        /* Decrypt data */
+        if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) ==
+            (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
+        {
+          status_code = StSafeA_DataDecryption(pStSafeA);
         }
+#endif /* STSAFE_A100 */
+      }
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
 
-        if (status_code == STSAFEA_OK)
-        {
-          pOutSharedSecret->Length = pStSafeA->InOutBuffer.LV.Length;
+      if (status_code == STSAFEA_OK)
+      {
+        pOutSharedSecret->Length = pStSafeA->InOutBuffer.LV.Length;
 
-          /* Assign the internal StSafeA_SharedSecretBuffer_t LVBuffer */
-          status_code = StSafeA_AssignLVBuffer(&pOutSharedSecret->SharedKey,
-                                               pStSafeA->InOutBuffer.LV.Data,
-                                               InSharedSecretLength);
-        }
+        /* Assign the internal StSafeA_SharedSecretBuffer_t LVBuffer */
+        status_code = StSafeA_AssignLVBuffer(&pOutSharedSecret->SharedKey,
+                                             pStSafeA->InOutBuffer.LV.Data,
+                                             InSharedSecretLength, pStSafeA->InPlaceResponse);
       }
     }
   }
@@ -1774,133 +2079,121 @@ StSafeA_ResponseCode_t StSafeA_ProductDataQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_PRODUCT_DATA;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_PRODUCT_DATA_QUERY_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_PRODUCT_DATA_QUERY_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutProductData->Length = pStSafeA->InOutBuffer.LV.Length;
-
-        uint8_t i = 0;
-
-        /* Mask Identification */
-        pOutProductData->MaskIdentificationTag    = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->MaskIdentificationLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->MaskIdentification,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->MaskIdentificationLength);
-        i += pOutProductData->MaskIdentificationLength;
-
-        /* ST Number */
-        pOutProductData->STNumberTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->STNumberLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->STNumber,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->STNumberLength);
-        i += pOutProductData->STNumberLength;
-
-        /* Input output buffer length */
-        pOutProductData->InputOutputBufferSizeTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->InputOutputBufferSizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(&pOutProductData->InputOutputBufferSize,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->InputOutputBufferSizeLength);
-        pOutProductData->InputOutputBufferSize = (uint16_t)SWAP2BYTES(pOutProductData->InputOutputBufferSize);
-        i += 2U;
-
-        /* Atomicity buffer length */
-        pOutProductData->AtomicityBufferSizeTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->AtomicityBufferSizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(&pOutProductData->AtomicityBufferSize,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->AtomicityBufferSizeLength);
-        pOutProductData->AtomicityBufferSize = (uint16_t)SWAP2BYTES(pOutProductData->AtomicityBufferSize);
-        i += 2U;
-
-        /* Size of non-volatile memory */
-        pOutProductData->NonVolatileMemorySizeTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->NonVolatileMemorySizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(&pOutProductData->NonVolatileMemorySize,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->NonVolatileMemorySizeLength);
-        pOutProductData->NonVolatileMemorySize = (uint16_t)SWAP2BYTES(pOutProductData->NonVolatileMemorySize);
-        i += 2U;
-
-        /* Test date */
-        pOutProductData->TestDateTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->TestDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(&pOutProductData->TestDateSize,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->TestDateLength);
-        pOutProductData->TestDateSize = (uint16_t)SWAP2BYTES(pOutProductData->TestDateSize);
-        i += 2U;
-
-        /* Internal product version */
-        pOutProductData->InternalProductVersionTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->InternalProductVersionLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        pOutProductData->InternalProductVersionSize = pStSafeA->InOutBuffer.LV.Data[++i];
-
-        /* Module date */
-        pOutProductData->ModuleDateTag = pStSafeA->InOutBuffer.LV.Data[++i];
-        pOutProductData->ModuleDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(&pOutProductData->ModuleDateSize,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->ModuleDateLength);
-        pOutProductData->ModuleDateSize = (uint16_t)SWAP2BYTES(pOutProductData->ModuleDateSize);
-        i += 2U;
+      pOutProductData->Length = pStSafeA->InOutBuffer.LV.Length;
+
+      uint8_t i = 0;
+
+      /* Mask Identification */
+      pOutProductData->MaskIdentificationTag    = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->MaskIdentificationLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->MaskIdentification,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->MaskIdentificationLength);
+      i += pOutProductData->MaskIdentificationLength;
+
+      /* ST Number */
+      pOutProductData->STNumberTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->STNumberLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->STNumber,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->STNumberLength);
+      i += pOutProductData->STNumberLength;
+
+      /* Input output buffer length */
+      pOutProductData->InputOutputBufferSizeTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->InputOutputBufferSizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(&pOutProductData->InputOutputBufferSize,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->InputOutputBufferSizeLength);
+      pOutProductData->InputOutputBufferSize = (uint16_t)SWAP2BYTES(pOutProductData->InputOutputBufferSize);
+      i += 2U;
+
+      /* Atomicity buffer length */
+      pOutProductData->AtomicityBufferSizeTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->AtomicityBufferSizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(&pOutProductData->AtomicityBufferSize,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->AtomicityBufferSizeLength);
+      pOutProductData->AtomicityBufferSize = (uint16_t)SWAP2BYTES(pOutProductData->AtomicityBufferSize);
+      i += 2U;
+
+      /* Size of non-volatile memory */
+      pOutProductData->NonVolatileMemorySizeTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->NonVolatileMemorySizeLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(&pOutProductData->NonVolatileMemorySize,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->NonVolatileMemorySizeLength);
+      pOutProductData->NonVolatileMemorySize = (uint16_t)SWAP2BYTES(pOutProductData->NonVolatileMemorySize);
+      i += 2U;
+
+      /* Test date */
+      pOutProductData->TestDateTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->TestDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(&pOutProductData->TestDateSize,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->TestDateLength);
+      pOutProductData->TestDateSize = (uint16_t)SWAP2BYTES(pOutProductData->TestDateSize);
+      i += 2U;
+
+      /* Internal product version */
+      pOutProductData->InternalProductVersionTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->InternalProductVersionLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      pOutProductData->InternalProductVersionSize = pStSafeA->InOutBuffer.LV.Data[++i];
+
+      /* Module date */
+      pOutProductData->ModuleDateTag = pStSafeA->InOutBuffer.LV.Data[++i];
+      pOutProductData->ModuleDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(&pOutProductData->ModuleDateSize,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->ModuleDateLength);
+      pOutProductData->ModuleDateSize = (uint16_t)SWAP2BYTES(pOutProductData->ModuleDateSize);
+      i += 2U;
 
 #if defined(STSAFE_A110)
-        /* Firmware delivery traceability */
-        pOutProductData->FirmwareDeliveryTraceabilityTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->FirmwareDeliveryTraceabilityLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->FirmwareDeliveryTraceability,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->FirmwareDeliveryTraceabilityLength);
-        i += pOutProductData->FirmwareDeliveryTraceabilityLength;
-
-        /* Blackbox delivery traceability */
-        pOutProductData->BlackboxDeliveryTraceabilityTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->BlackboxDeliveryTraceabilityLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->BlackboxDeliveryTraceability,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->BlackboxDeliveryTraceabilityLength);
-        i += pOutProductData->BlackboxDeliveryTraceabilityLength;
-
-        /* Perso ID */
-        pOutProductData->PersoIdTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->PersoIdLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->PersoId,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->PersoIdLength);
-        i += pOutProductData->PersoIdLength;
-
-        /* Perso generation batch ID */
-        pOutProductData->PersoGenerationBatchIdTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->PersoGenerationBatchIdLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->PersoGenerationBatchId,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->PersoGenerationBatchIdLength);
-        i += pOutProductData->PersoGenerationBatchIdLength;
-
-        /* Perso date */
-        pOutProductData->PersoDateTag = pStSafeA->InOutBuffer.LV.Data[i];
-        pOutProductData->PersoDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
-        (void)memcpy(pOutProductData->PersoDate,
-                     &pStSafeA->InOutBuffer.LV.Data[++i],
-                     pOutProductData->PersoDateLength);
+      /* Firmware delivery traceability */
+      pOutProductData->FirmwareDeliveryTraceabilityTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->FirmwareDeliveryTraceabilityLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->FirmwareDeliveryTraceability,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->FirmwareDeliveryTraceabilityLength);
+      i += pOutProductData->FirmwareDeliveryTraceabilityLength;
+
+      /* Blackbox delivery traceability */
+      pOutProductData->BlackboxDeliveryTraceabilityTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->BlackboxDeliveryTraceabilityLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->BlackboxDeliveryTraceability,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->BlackboxDeliveryTraceabilityLength);
+      i += pOutProductData->BlackboxDeliveryTraceabilityLength;
+
+      /* Perso ID */
+      pOutProductData->PersoIdTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->PersoIdLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->PersoId,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->PersoIdLength);
+      i += pOutProductData->PersoIdLength;
+
+      /* Perso generation batch ID */
+      pOutProductData->PersoGenerationBatchIdTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->PersoGenerationBatchIdLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->PersoGenerationBatchId,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->PersoGenerationBatchIdLength);
+      i += pOutProductData->PersoGenerationBatchIdLength;
+
+      /* Perso date */
+      pOutProductData->PersoDateTag = pStSafeA->InOutBuffer.LV.Data[i];
+      pOutProductData->PersoDateLength = pStSafeA->InOutBuffer.LV.Data[++i];
+      (void)memcpy(pOutProductData->PersoDate,
+                   &pStSafeA->InOutBuffer.LV.Data[++i],
+                   pOutProductData->PersoDateLength);
 #endif /* STSAFE_A110 */
-      }
     }
   }
 
@@ -1939,29 +2232,17 @@ StSafeA_ResponseCode_t StSafeA_I2cParameterQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_I2C_PARAMETER;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_I2C_PARAMETERS_QUERY_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_I2C_PARAMETERS_QUERY_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutI2CParamData->Length               = pStSafeA->InOutBuffer.LV.Length;
-        pOutI2CParamData->I2cAddress           = pStSafeA->InOutBuffer.LV.Data[0] >> 1;
-        /* 1-bit: the 8th  */
-        pOutI2CParamData->LockConfig           = pStSafeA->InOutBuffer.LV.Data[1]  & STSAFEA_I2C_LOCK_MSK;
-        /* 2-bits : the 6th and 7th */
-        pOutI2CParamData->LowPowerModeConfig   = pStSafeA->InOutBuffer.LV.Data[1]  & STSAFEA_I2C_LPMODE_MSK;
-      }
+      pOutI2CParamData->Length               = pStSafeA->InOutBuffer.LV.Length;
+      pOutI2CParamData->I2cAddress           = pStSafeA->InOutBuffer.LV.Data[0] >> 1;
+      /* 1-bit: the 8th  */
+      pOutI2CParamData->LockConfig           = pStSafeA->InOutBuffer.LV.Data[1]  & STSAFEA_I2C_LOCK_MSK;
+      /* 2-bits : the 6th and 7th */
+      pOutI2CParamData->LowPowerModeConfig   = pStSafeA->InOutBuffer.LV.Data[1]  & STSAFEA_I2C_LPMODE_MSK;
     }
   }
 
@@ -1999,25 +2280,13 @@ StSafeA_ResponseCode_t StSafeA_LifeCycleStateQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_LIFE_CYCLE_STATE;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_LIFE_CYCLE_STATE_QUERY_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_LIFE_CYCLE_STATE_QUERY_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        pOutLifeCycleState->Length          = pStSafeA->InOutBuffer.LV.Length;
-        pOutLifeCycleState->LifeCycleStatus = pStSafeA->InOutBuffer.LV.Data[0];
-      }
+      pOutLifeCycleState->Length          = pStSafeA->InOutBuffer.LV.Length;
+      pOutLifeCycleState->LifeCycleStatus = pStSafeA->InOutBuffer.LV.Data[0];
     }
   }
 
@@ -2055,33 +2324,21 @@ StSafeA_ResponseCode_t StSafeA_HostKeySlotQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_HOST_KEY_SLOT;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_HOST_KEY_SLOT_QUERY_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_HOST_KEY_SLOT_QUERY_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
+      pOutHostKeySlot->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutHostKeySlot->HostKeyPresenceFlag = pStSafeA->InOutBuffer.LV.Data[0];
 
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
+      /* Only 3-bytes for MAC Counter */
+      pOutHostKeySlot->HostCMacSequenceCounter = STSAFEA_HOST_CMAC_INVALID_COUNTER;
+      if (pOutHostKeySlot->HostKeyPresenceFlag != 0U)
       {
-        pOutHostKeySlot->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutHostKeySlot->HostKeyPresenceFlag = pStSafeA->InOutBuffer.LV.Data[0];
-
-        /* Only 3-bytes for MAC Counter */
-        pOutHostKeySlot->HostCMacSequenceCounter = STSAFEA_HOST_CMAC_INVALID_COUNTER;
-        if (pOutHostKeySlot->HostKeyPresenceFlag != 0U)
-        {
-          pOutHostKeySlot->HostCMacSequenceCounter  = ((uint32_t)pStSafeA->InOutBuffer.LV.Data[1]) << 16;
-          pOutHostKeySlot->HostCMacSequenceCounter |= ((uint32_t)pStSafeA->InOutBuffer.LV.Data[2]) << 8;
-          pOutHostKeySlot->HostCMacSequenceCounter |= pStSafeA->InOutBuffer.LV.Data[3];
-        }
+        pOutHostKeySlot->HostCMacSequenceCounter  = ((uint32_t)pStSafeA->InOutBuffer.LV.Data[1]) << 16;
+        pOutHostKeySlot->HostCMacSequenceCounter |= ((uint32_t)pStSafeA->InOutBuffer.LV.Data[2]) << 8;
+        pOutHostKeySlot->HostCMacSequenceCounter |= pStSafeA->InOutBuffer.LV.Data[3];
       }
     }
   }
@@ -2126,25 +2383,21 @@ StSafeA_ResponseCode_t StSafeA_PutAttribute(
     /* Use limit */
     if (InDataSize > 0U)
     {
-      STSAFEA_CHECK_SIZE(InMAC, 1U, InDataSize);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[1], pInData, InDataSize);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 1U, InDataSize);
+      StSafeA_CopyCommandData(pStSafeA, 1U, pInData, InDataSize);
     }
     pStSafeA->InOutBuffer.LV.Length = 1U + InDataSize;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
 
-    if (status_code == STSAFEA_OK)
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
+    /* A new host key restarts the Host C-MAC sequence counter */
+    if (InAttributeTag == STSAFEA_TAG_HOST_KEY_SLOT)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_PUT_ATTRIBUTE);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
+      pStSafeA->HostMacSequenceCounter = STSAFEA_HOST_CMAC_INVALID_COUNTER;
     }
+#endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
   }
 
   return status_code;
@@ -2177,20 +2430,8 @@ StSafeA_ResponseCode_t StSafeA_DeletePassword(
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
-    {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_DELETE_KEY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-    }
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
   }
 
   return status_code;
@@ -2229,31 +2470,19 @@ StSafeA_ResponseCode_t StSafeA_VerifyPassword(
 
     /* Build command data */
     /* Password */
-    (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[0], pInPassword, STSAFEA_PASSWORD_SIZE);
+    StSafeA_CopyCommandData(pStSafeA, 0U, pInPassword, STSAFEA_PASSWORD_SIZE);
 
     pStSafeA->InOutBuffer.LV.Length = STSAFEA_PASSWORD_SIZE;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_VERIFY_PASSWORD_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_VERIFY_PASSWORD_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_VERIFY_PASSWORD);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
+      pOutVerifyPassword->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutVerifyPassword->VerificationStatus = pStSafeA->InOutBuffer.LV.Data[0];
+      pOutVerifyPassword->RemainingTries     = pStSafeA->InOutBuffer.LV.Data[1];;
 
-      if (status_code == STSAFEA_OK)
-      {
-        pOutVerifyPassword->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutVerifyPassword->VerificationStatus = pStSafeA->InOutBuffer.LV.Data[0];
-        pOutVerifyPassword->RemainingTries     = pStSafeA->InOutBuffer.LV.Data[1];;
-
-      }
     }
   }
 
@@ -2273,7 +2502,8 @@ StSafeA_ResponseCode_t StSafeA_VerifyPassword(
   *                           If STSAFEA_USE_OPTIMIZATION_SHARED_RAM = 1 a pointer inside pStSafeA->InOutBuffer
   *                           will be assigned.
   * @param   DelayMs        : Waiting time in ms after the command has been sent, before checking
-  *                           for the received response.
+  *                           for the received response. It is applied as is: raw commands neither use nor
+  *                           update the learned processing times.
   * @param   InMAC          : MAC authenticating command/response.
   * @retval  STSAFEA_OK if success, an error code otherwise.
   */
@@ -2302,30 +2532,19 @@ StSafeA_ResponseCode_t StSafeA_RawCommand(
     StSafeA_BuildCommandHeaderCMAC(pStSafeA, pInRawCommand->Header, &InMAC);
 
     /* Build command */
-    STSAFEA_CHECK_SIZE(InMAC, 0U, pInRawCommand->LV.Length);
+    STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 0U, pInRawCommand->LV.Length);
     pStSafeA->InOutBuffer.LV.Length = pInRawCommand->LV.Length;
-    (void)memcpy(pStSafeA->InOutBuffer.LV.Data, pInRawCommand->LV.Data, pInRawCommand->LV.Length);
+    StSafeA_CopyCommandData(pStSafeA, 0U, pInRawCommand->LV.Data, pInRawCommand->LV.Length);
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command, waiting for the caller provided processing time, out of the learned processing times */
+    status_code = StSafeA_ExchangeCommand(pStSafeA, 0U, InMAC, DelayMs, DelayMs, STSAFEA_FLAG_FALSE);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(DelayMs);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-        /* Assign the received response to the output parameter */
-        pOutTLVResponse->Header = pStSafeA->InOutBuffer.Header;
-        status_code = StSafeA_AssignLVResponse(&pOutTLVResponse->LV, &pStSafeA->InOutBuffer.LV,  InRespDataLen);
-      }
+      /* Assign the received response to the output parameter */
+      pOutTLVResponse->Header = pStSafeA->InOutBuffer.Header;
+      status_code = StSafeA_AssignLVResponse(&pOutTLVResponse->LV, &pStSafeA->InOutBuffer.LV,  InRespDataLen,
+                                             pStSafeA->InPlaceResponse);
     }
   }
 
@@ -2397,49 +2616,37 @@ StSafeA_ResponseCode_t StSafeA_LocalEnvelopeKeySlotQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_LOCAL_ENVELOPE_KEY_TABLE;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_LOCAL_ENVELOPE_QUERY_MIN_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_LOCAL_ENVELOPE_QUERY_MIN_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
+      uint8_t idx = 0;
+      pOutLocalEnvelopeKeyTable->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutLocalEnvelopeKeyTable->NumberOfSlots = pStSafeA->InOutBuffer.LV.Data[idx];
 
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
+      if (pOutLocalEnvelopeKeyTable->NumberOfSlots != 0U)
       {
-        uint8_t idx = 0;
-        pOutLocalEnvelopeKeyTable->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutLocalEnvelopeKeyTable->NumberOfSlots = pStSafeA->InOutBuffer.LV.Data[idx];
-
-        if (pOutLocalEnvelopeKeyTable->NumberOfSlots != 0U)
+        /* Fill the Slot-0 Information record */
+        idx++;
+        pOutLlocalEnvelopeKeySlot0InformationRecord->SlotNumber   = pStSafeA->InOutBuffer.LV.Data[idx];
+        idx++;
+        pOutLlocalEnvelopeKeySlot0InformationRecord->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[idx];
+        if (pOutLlocalEnvelopeKeySlot0InformationRecord->PresenceFlag != 0U)
         {
-          /* Fill the Slot-0 Information record */
-          idx++;
-          pOutLlocalEnvelopeKeySlot0InformationRecord->SlotNumber   = pStSafeA->InOutBuffer.LV.Data[idx];
           idx++;
-          pOutLlocalEnvelopeKeySlot0InformationRecord->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[idx];
-          if (pOutLlocalEnvelopeKeySlot0InformationRecord->PresenceFlag != 0U)
-          {
-            idx++;
-            pOutLlocalEnvelopeKeySlot0InformationRecord->KeyLength = pStSafeA->InOutBuffer.LV.Data[idx];
-          }
+          pOutLlocalEnvelopeKeySlot0InformationRecord->KeyLength = pStSafeA->InOutBuffer.LV.Data[idx];
+        }
 
-          /* Fill the Slot-1 Information record */
-          idx++;
-          pOutLlocalEnvelopeKeySlot1InformationRecord->SlotNumber   = pStSafeA->InOutBuffer.LV.Data[idx];
+        /* Fill the Slot-1 Information record */
+        idx++;
+        pOutLlocalEnvelopeKeySlot1InformationRecord->SlotNumber   = pStSafeA->InOutBuffer.LV.Data[idx];
+        idx++;
+        pOutLlocalEnvelopeKeySlot1InformationRecord->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[idx];
+        if (pOutLlocalEnvelopeKeySlot1InformationRecord->PresenceFlag != 0U)
+        {
           idx++;
-          pOutLlocalEnvelopeKeySlot1InformationRecord->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[idx];
-          if (pOutLlocalEnvelopeKeySlot1InformationRecord->PresenceFlag != 0U)
-          {
-            idx++;
-            pOutLlocalEnvelopeKeySlot1InformationRecord->KeyLength = pStSafeA->InOutBuffer.LV.Data[idx];
-          }
+          pOutLlocalEnvelopeKeySlot1InformationRecord->KeyLength = pStSafeA->InOutBuffer.LV.Data[idx];
         }
       }
     }
@@ -2497,29 +2704,17 @@ StSafeA_ResponseCode_t StSafeA_GenerateLocalEnvelopeKey(
     pStSafeA->InOutBuffer.LV.Data[2] = (uint8_t)InKeyType;
 
     /*Seed (can be optional, so the related pointer is not checked at the beginning)*/
-    uint16_t seed_size = InSeedSize;
-    if ((seed_size > 0U)  && (pInSeed != NULL))
-    {
-      STSAFEA_CHECK_SIZE(InMAC, 3U, seed_size);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[3], pInSeed, seed_size);
-    }
-
-    pStSafeA->InOutBuffer.LV.Length = 3U + seed_size;
-
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
+    uint16_t seed_size = InSeedSize;
+    if ((seed_size > 0U)  && (pInSeed != NULL))
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 3U, seed_size);
+      StSafeA_CopyCommandData(pStSafeA, 3U, pInSeed, seed_size);
+    }
 
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_GENERATE_KEY);
+    pStSafeA->InOutBuffer.LV.Length = 3U + seed_size;
 
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-    }
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
   }
 
   return status_code;
@@ -2582,8 +2777,8 @@ StSafeA_ResponseCode_t StSafeA_WrapLocalEnvelope(
 
     if ((pInData != NULL) && (InDataSize > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, 1U, InDataSize);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[1], pInData, InDataSize);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 1U, InDataSize);
+      StSafeA_CopyCommandData(pStSafeA, 1U, pInData, InDataSize);
     }
     pStSafeA->InOutBuffer.LV.Length = InDataSize + 1U;
 
@@ -2605,30 +2800,19 @@ StSafeA_ResponseCode_t StSafeA_WrapLocalEnvelope(
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
       /* Transmit */
     {
-      status_code = StSafeA_TransmitCommand(pStSafeA);
+      status_code = StSafeA_ExecuteCommand(pStSafeA,
+                                           InDataSize + STSAFEA_WRAP_UNWRAP_ENVELOPE_ADDITIONAL_RESPONSE_LENGTH,
+                                           InMAC);
 
       if (status_code == STSAFEA_OK)
       {
-        /* Set response length */
-        pStSafeA->InOutBuffer.LV.Length = InDataSize +
-                                          STSAFEA_WRAP_UNWRAP_ENVELOPE_ADDITIONAL_RESPONSE_LENGTH +
-                                          STSAFEA_R_MAC_LENGTH(InMAC);
+        /* Local Envelope response data is 8-bytes longer than the working key (see User Manual).
+          Need to compensate the input length before the assignment function call.
+          WARNING: Must be clear at App level to allocate additional 8-Bytes to avoid overflow!*/
 
-        /* Wait for the command processing. Then check for the response */
-        StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_WRAP_LOCAL_ENVELOPE);
-
-        /* Receive */
-        status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-        if (status_code == STSAFEA_OK)
-        {
-          /* Local Envelope response data is 8-bytes longer than the working key (see User Manual).
-            Need to compensate the input length before the assignment function call.
-            WARNING: Must be clear at App level to allocate additional 8-Bytes to avoid overflow!*/
-
-          /* Assign the internal StSafeA_SharedSecretBuffer_t LVBuffer */
-          status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InDataSize + 8U);
-        }
+        /* Assign the internal StSafeA_SharedSecretBuffer_t LVBuffer */
+        status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV, InDataSize + 8U,
+                                               pStSafeA->InPlaceResponse);
       }
     }
   }
@@ -2693,47 +2877,36 @@ StSafeA_ResponseCode_t StSafeA_UnwrapLocalEnvelope(
 
     if ((pInLocalEnvelope != NULL) && (InLocalEnvelopeSize > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, 1U, InLocalEnvelopeSize);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[1], pInLocalEnvelope, InLocalEnvelopeSize);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 1U, InLocalEnvelopeSize);
+      StSafeA_CopyCommandData(pStSafeA, 1U, pInLocalEnvelope, InLocalEnvelopeSize);
     }
     pStSafeA->InOutBuffer.LV.Length = InLocalEnvelopeSize + 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA,
+                                         InLocalEnvelopeSize + STSAFEA_WRAP_UNWRAP_ENVELOPE_ADDITIONAL_RESPONSE_LENGTH,
+                                         InMAC);
 
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = InLocalEnvelopeSize +
-                                        STSAFEA_WRAP_UNWRAP_ENVELOPE_ADDITIONAL_RESPONSE_LENGTH +
-                                        STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_UNWRAP_LOCAL_ENVELOPE);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
-      if (status_code == STSAFEA_OK)
-      {
 #if defined(STSAFE_A100)
-        status_code = StSafeA_DataDecryption(pStSafeA);
+      status_code = StSafeA_DataDecryption(pStSafeA);
 #else
-        /* Decrypt data */
-        if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) == (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
-        {
-          status_code = StSafeA_DataDecryption(pStSafeA);
-        }
-#endif /* STSAFE_A100 */
+      /* Decrypt data */
+      if (((uint8_t)InHostEncryption & (uint8_t)STSAFEA_ENCRYPTION_RESPONSE) == (uint8_t)STSAFEA_ENCRYPTION_RESPONSE)
+      {
+        status_code = StSafeA_DataDecryption(pStSafeA);
       }
+#endif /* STSAFE_A100 */
+    }
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
 
-      if (status_code == STSAFEA_OK)
-      {
-        /* Assign the received response to the output parameter */
-        status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV,  InLocalEnvelopeSize);
-      }
+    if (status_code == STSAFEA_OK)
+    {
+      /* Assign the received response to the output parameter */
+      status_code = StSafeA_AssignLVResponse(pOutLVResponse, &pStSafeA->InOutBuffer.LV,  InLocalEnvelopeSize,
+                                             pStSafeA->InPlaceResponse);
     }
   }
 
@@ -2755,6 +2928,59 @@ StSafeA_ResponseCode_t StSafeA_UnwrapLocalEnvelope(
   * @{
   */
 
+/**
+  * @brief   StSafeA_ExecuteCommand
+  *          Static function to execute the already prepared command: transmit it, wait for the processing time
+  *          of its command code given by the command table and receive its response.
+  *
+  * @param   pStSafeA      : STSAFE-A1xx object pointer.
+  * @param   RespDataLen   : Expected length of the response data, R-MAC excluded.
+  * @param   InMAC         : MAC authenticating command/response, as returned by StSafeA_BuildCommandHeaderCMAC.
+  * @retval  STSAFEA_OK if success, an error code otherwise.
+  */
+static StSafeA_ResponseCode_t StSafeA_ExecuteCommand(StSafeA_Handle_t *pStSafeA, uint16_t RespDataLen, uint8_t InMAC)
+{
+  const StSafeA_CommandDescriptor_t *p_command =
+    &StSafeA_CommandTable[pStSafeA->InOutBuffer.Header & STSAFEA_CMD_HEADER_CODE_MSK];
+
+  return StSafeA_ExchangeCommand(pStSafeA, RespDataLen, InMAC, p_command->MsWaitTime, p_command->MsMinWaitTime,
+                                 STSAFEA_FLAG_TRUE);
+}
+
+/**
+  * @brief   StSafeA_ExchangeCommand
+  *          Static function to transmit the already prepared command, wait for the given processing time and
+  *          receive its response.
+  *
+  * @param   pStSafeA      : STSAFE-A1xx object pointer.
+  * @param   RespDataLen   : Expected length of the response data, R-MAC excluded.
+  * @param   InMAC         : MAC authenticating command/response, as returned by StSafeA_BuildCommandHeaderCMAC.
+  * @param   MsWaitTime    : Worst case processing time in ms.
+  * @param   MsMinWaitTime : Minimum processing time in ms.
+  * @param   Learned       : STSAFEA_FLAG_TRUE to wait for and record the learned processing times of the command
+  *                          code, STSAFEA_FLAG_FALSE to wait for MsWaitTime and record nothing.
+  * @retval  STSAFEA_OK if success, an error code otherwise.
+  */
+static StSafeA_ResponseCode_t StSafeA_ExchangeCommand(StSafeA_Handle_t *pStSafeA, uint16_t RespDataLen, uint8_t InMAC,
+                                                      uint32_t MsWaitTime, uint32_t MsMinWaitTime, uint8_t Learned)
+{
+  StSafeA_ResponseCode_t status_code = StSafeA_TransmitCommand(pStSafeA);
+
+  if (status_code == STSAFEA_OK)
+  {
+    /* Set response length */
+    pStSafeA->InOutBuffer.LV.Length = RespDataLen + STSAFEA_R_MAC_LENGTH(InMAC);
+
+    /* Wait for the command processing. Then check for the response */
+    StSafeA_WaitResponse(pStSafeA, MsWaitTime, MsMinWaitTime, Learned);
+
+    /* Receive */
+    status_code = StSafeA_ReceiveResponse(pStSafeA, Learned);
+  }
+
+  return status_code;
+}
+
 /**
   * @brief   StSafeA_TransmitCommand
   *          Static function to transmit the already prepared command to the STSAFE-A device.
@@ -2767,11 +2993,35 @@ static StSafeA_ResponseCode_t StSafeA_TransmitCommand(StSafeA_Handle_t *pStSafeA
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
   if (pStSafeA != NULL)
   {
+    /* The responses pointed inside the I/O buffer are overwritten from now on */
+    pStSafeA->CommandCounter++;
+
+    /* The deadline covers the command sending, processing and response reading */
+    pStSafeA->HwCtx.TimeLeft = (pStSafeA->HwCtx.Deadline != 0U) ? pStSafeA->HwCtx.Deadline : STSAFEA_NO_DEADLINE;
+    if (pStSafeA->HwCtx.TimeGetUs != NULL)
+    {
+      pStSafeA->HwCtx.CommandStart = pStSafeA->HwCtx.TimeGetUs();
+    }
+    STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_BUILD, 0U);
+
     status_code = StSafeA_MAC_SHA_PrePostProcess(pStSafeA, STSAFEA_MAC_SHA_PRE_PROCESS);
+    STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_MAC_PRE, 0U);
     if (status_code == STSAFEA_OK)
     {
-      status_code = StSafeA_Transmit(&pStSafeA->InOutBuffer, pStSafeA->CrcSupport);
+      status_code = StSafeA_Transmit(&pStSafeA->HwCtx, &pStSafeA->InOutBuffer, pStSafeA->CrcSupport);
+    }
+
+    if (status_code != STSAFEA_OK)
+    {
+      STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_END, status_code);
     }
+
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
+    if (status_code != STSAFEA_OK)
+    {
+      StSafeA_UpdateHostMacSequenceCounter(pStSafeA, pStSafeA->InOutBuffer.Header, status_code);
+    }
+#endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
   }
 
   return status_code;
@@ -2782,25 +3032,200 @@ static StSafeA_ResponseCode_t StSafeA_TransmitCommand(StSafeA_Handle_t *pStSafeA
   *          Static function to receive the esponse from the STSAFE-A device, after a command has been transmitted.
   *
   * @param   pStSafeA      : STSAFE-A1xx object pointer.
+  * @param   Learned       : STSAFEA_FLAG_TRUE to record the processing time of the command code.
   * @retval  STSAFEA_OK if success, an error code otherwise.
   */
-static StSafeA_ResponseCode_t StSafeA_ReceiveResponse(StSafeA_Handle_t *pStSafeA)
+static StSafeA_ResponseCode_t StSafeA_ReceiveResponse(StSafeA_Handle_t *pStSafeA, uint8_t Learned)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
   if (pStSafeA != NULL)
   {
-    status_code = StSafeA_Receive(&pStSafeA->InOutBuffer, pStSafeA->CrcSupport);
+    /* The header is overwritten by the response */
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+    uint8_t command_code = pStSafeA->InOutBuffer.Header & STSAFEA_CMD_HEADER_CODE_MSK;
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
+    uint8_t command_header = pStSafeA->InOutBuffer.Header;
+#endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
+
+    status_code = StSafeA_Receive(&pStSafeA->HwCtx, &pStSafeA->InOutBuffer, pStSafeA->CrcSupport);
     if (status_code == STSAFEA_OK)
     {
       pStSafeA->MacCounter ++;
 
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+      if (Learned == STSAFEA_FLAG_TRUE)
+      {
+        StSafeA_UpdateLatencyModel(pStSafeA, command_code);
+      }
+#else
+      STSAFEA_UNUSED_VAR(Learned);
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
       status_code = StSafeA_MAC_SHA_PrePostProcess(pStSafeA, STSAFEA_MAC_SHA_POST_PROCESS);
+      STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_MAC_POST, 0U);
     }
+
+#if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
+    StSafeA_UpdateHostMacSequenceCounter(pStSafeA, command_header, status_code);
+#endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
+    STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_END, status_code);
   }
 
   return status_code;
 }
 
+/**
+  * @brief   StSafeA_WaitResponse
+  *          Static function to wait for the command processing, after a command has been transmitted.
+  * @note    With STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING = 1 the response is polled afterwards, so the wait
+  *          only needs to cover the shortest processing time.
+  *
+  * @param   pStSafeA      : STSAFE-A1xx object pointer.
+  * @param   MsWaitTime    : Worst case command processing time in ms.
+  * @param   MsMinWaitTime : Minimum command processing time in ms.
+  * @param   Learned       : STSAFEA_FLAG_TRUE to wait for the learned processing time of the command code,
+  *                          STSAFEA_FLAG_FALSE to wait for MsWaitTime.
+  * @retval  None
+  */
+static void StSafeA_WaitResponse(StSafeA_Handle_t *pStSafeA, uint32_t MsWaitTime, uint32_t MsMinWaitTime,
+                                 uint8_t Learned)
+{
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+  if (Learned == STSAFEA_FLAG_TRUE)
+  {
+    pStSafeA->WaitTime = StSafeA_GetLearnedWaitTime(pStSafeA, MsWaitTime, MsMinWaitTime);
+  }
+  else
+  {
+    pStSafeA->WaitTime = MsWaitTime;
+  }
+  StSafeA_Delay(&pStSafeA->HwCtx, pStSafeA->WaitTime);
+  STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_WAIT, pStSafeA->WaitTime);
+#elif (STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING)
+  STSAFEA_UNUSED_VAR(Learned);
+  (void)MsWaitTime;
+  StSafeA_Delay(&pStSafeA->HwCtx, MsMinWaitTime);
+  STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_WAIT, MsMinWaitTime);
+#else
+  STSAFEA_UNUSED_VAR(Learned);
+  (void)MsMinWaitTime;
+  StSafeA_Delay(&pStSafeA->HwCtx, MsWaitTime);
+  STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_WAIT, MsWaitTime);
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+}
+
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME)
+/**
+  * @brief   StSafeA_GetLearnedWaitTime
+  *          Static function to compute the delay to apply before polling the response of the command being
+  *          processed, from the processing times learned for its command code.
+  * @note    Returns MsMinWaitTime until STSAFEA_LATENCY_MODEL_MIN_SAMPLES responses have been recorded.
+  *
+  * @param   pStSafeA      : STSAFE-A1xx object pointer, with the transmitted command header.
+  * @param   MsWaitTime    : Worst case command processing time in ms.
+  * @param   MsMinWaitTime : Minimum command processing time in ms.
+  * @retval  Delay in ms, between MsMinWaitTime and MsWaitTime.
+  */
+static uint32_t StSafeA_GetLearnedWaitTime(StSafeA_Handle_t *pStSafeA, uint32_t MsWaitTime, uint32_t MsMinWaitTime)
+{
+  StSafeA_LatencyHistogram_t *p_histogram =
+    &pStSafeA->LatencyModel.Cmd[pStSafeA->InOutBuffer.Header & STSAFEA_CMD_HEADER_CODE_MSK];
+  uint32_t wait_time = MsMinWaitTime;
+  uint32_t samples = 0;
+  uint32_t threshold;
+  uint8_t i;
+
+  if (p_histogram->BinWidth == 0U)
+  {
+    /* First use of this command code: spread the bins over its worst case processing time */
+    uint32_t bin_width = (MsWaitTime + STSAFEA_LATENCY_MODEL_BIN_NUMBER - 1U) / STSAFEA_LATENCY_MODEL_BIN_NUMBER;
+    if (bin_width == 0U)
+    {
+      bin_width = 1U;
+    }
+    p_histogram->BinWidth = (bin_width > 0xFFU) ? 0xFFU : (uint8_t)bin_width;
+  }
+
+  for (i = 0; i < STSAFEA_LATENCY_MODEL_BIN_NUMBER; i++)
+  {
+    samples += p_histogram->Bins[i];
+  }
+
+  if (samples >= STSAFEA_LATENCY_MODEL_MIN_SAMPLES)
+  {
+    /* Find the first bin reaching the percentile, and wait until its lower bound */
+    threshold = ((samples * STSAFEA_LATENCY_MODEL_PERCENTILE) + 99U) / 100U;
+    samples = 0;
+    for (i = 0; i < (STSAFEA_LATENCY_MODEL_BIN_NUMBER - 1U); i++)
+    {
+      samples += p_histogram->Bins[i];
+      if (samples >= threshold)
+      {
+        break;
+      }
+    }
+
+    wait_time = (uint32_t)i * p_histogram->BinWidth;
+    if (wait_time < MsMinWaitTime)
+    {
+      wait_time = MsMinWaitTime;
+    }
+    if (wait_time > MsWaitTime)
+    {
+      wait_time = MsWaitTime;
+    }
+  }
+
+  return wait_time;
+}
+
+/**
+  * @brief   StSafeA_UpdateLatencyModel
+  *          Static function to record the processing time of the last received response.
+  * @note    The processing time is the delay applied before the first response reading plus the time spent
+  *          polling the device.
+  *
+  * @param   pStSafeA    : STSAFE-A1xx object pointer.
+  * @param   CommandCode : Code of the command the response belongs to.
+  * @retval  None
+  */
+static void StSafeA_UpdateLatencyModel(StSafeA_Handle_t *pStSafeA, uint8_t CommandCode)
+{
+  StSafeA_LatencyHistogram_t *p_histogram = &pStSafeA->LatencyModel.Cmd[CommandCode & STSAFEA_CMD_HEADER_CODE_MSK];
+  uint32_t polling_time = StSafeA_GetResponsePollingTime(&pStSafeA->HwCtx);
+  uint32_t bin;
+  uint8_t i;
+
+  if (p_histogram->BinWidth != 0U)
+  {
+    bin = (pStSafeA->WaitTime + polling_time) / p_histogram->BinWidth;
+
+    /* The response was already available at the first reading, so the processing may have been shorter
+       than the delay: record it one bin earlier, so that shorter delays keep being tried */
+    if ((polling_time == 0U) && (bin > 0U))
+    {
+      bin--;
+    }
+
+    if (bin >= STSAFEA_LATENCY_MODEL_BIN_NUMBER)
+    {
+      bin = STSAFEA_LATENCY_MODEL_BIN_NUMBER - 1U;
+    }
+
+    /* On saturation halve the whole histogram, which also ages out the old processing times */
+    if (p_histogram->Bins[bin] == STSAFEA_LATENCY_MODEL_BIN_MAX)
+    {
+      for (i = 0; i < STSAFEA_LATENCY_MODEL_BIN_NUMBER; i++)
+      {
+        p_histogram->Bins[i] >>= 1;
+      }
+    }
+    p_histogram->Bins[bin]++;
+  }
+}
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
 /**
   * @brief   StSafeA_AssignLVResponse
   *          Static function used to assign the  LV structure from the received response.
@@ -2810,11 +3235,13 @@ static StSafeA_ResponseCode_t StSafeA_ReceiveResponse(StSafeA_Handle_t *pStSafeA
   * @param   ExpectedLen   : Expected data length.
   *                          If STSAFEA_USE_OPTIMIZATION_SHARED_RAM = 0, must correspond to the memory allocated
   *                          for pDestLVBuffer->Data.
+  * @param   InPlace       : pStSafeA->InPlaceResponse, see StSafeA_SetLVData.
   * @retval  STSAFEA_OK if success, an error code otherwise.
   */
 static StSafeA_ResponseCode_t StSafeA_AssignLVResponse(StSafeA_LVBuffer_t *pDestLVBuffer,
                                                        StSafeA_LVBuffer_t *pSrcLVBuffer,
-                                                       uint16_t ExpectedLen)
+                                                       uint16_t ExpectedLen,
+                                                       uint8_t InPlace)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
   if ((pDestLVBuffer != NULL)  && (pSrcLVBuffer != NULL))
@@ -2832,7 +3259,7 @@ static StSafeA_ResponseCode_t StSafeA_AssignLVResponse(StSafeA_LVBuffer_t *pDest
     pDestLVBuffer->Length = pSrcLVBuffer->Length;
 
     /* Set the Data of the LVBuffer according to the selected Shared Ram optimization */
-    StSafeA_SetLVData(pDestLVBuffer, pSrcLVBuffer->Data, pDestLVBuffer->Length);
+    StSafeA_SetLVData(pDestLVBuffer, pSrcLVBuffer->Data, pDestLVBuffer->Length, InPlace);
   }
   return status_code;
 }
@@ -2846,11 +3273,13 @@ static StSafeA_ResponseCode_t StSafeA_AssignLVResponse(StSafeA_LVBuffer_t *pDest
   * @param   ExpectedLen   : Expected data length.
   *                          If STSAFEA_USE_OPTIMIZATION_SHARED_RAM = 0, must correspond to the memory
   *                          allocated for pDestLVBuffer->Data.
+  * @param   InPlace       : pStSafeA->InPlaceResponse, see StSafeA_SetLVData.
   * @retval  STSAFEA_OK if success, an error code otherwise.
   */
 static StSafeA_ResponseCode_t StSafeA_AssignLVBuffer(StSafeA_LVBuffer_t *pDestLVBuffer,
                                                      uint8_t *pDataBuffer,
-                                                     uint16_t ExpectedLen)
+                                                     uint16_t ExpectedLen,
+                                                     uint8_t InPlace)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
   if ((pDestLVBuffer != NULL)  && (pDataBuffer != NULL))
@@ -2869,7 +3298,7 @@ static StSafeA_ResponseCode_t StSafeA_AssignLVBuffer(StSafeA_LVBuffer_t *pDestLV
     }
 
     /* Set the Data of the LVBuffer according to the selected Shared Ram optimization */
-    StSafeA_SetLVData(pDestLVBuffer, &pDataBuffer[2U], pDestLVBuffer->Length);
+    StSafeA_SetLVData(pDestLVBuffer, &pDataBuffer[2U], pDestLVBuffer->Length, InPlace);
   }
   return status_code;
 }
@@ -2884,12 +3313,17 @@ static StSafeA_ResponseCode_t StSafeA_AssignLVBuffer(StSafeA_LVBuffer_t *pDestLV
   * @param   pSrcLVData    : Pointer to source bytes array to fill from.
   * @param   Length        : If STSAFEA_USE_OPTIMIZATION_SHARED_RAM = 0, must correspond to the memory allocated for
   *                           pDestLVBuffer->Data.
+  * @param   InPlace       : If STSAFEA_USE_OPTIMIZATION_SHARED_RAM = 0 and pDestLVBuffer->Data is NULL,
+  *                          STSAFEA_FLAG_TRUE assigns a pointer inside pStSafeA->InOutBuffer as well. It is valid
+  *                          until the next command, which increments pStSafeA->CommandCounter.
   * @retval  none
   */
-static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLVData,  uint16_t Length)
+static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLVData,  uint16_t Length,
+                              uint8_t InPlace)
 {
 #if (STSAFEA_USE_OPTIMIZATION_SHARED_RAM)
   STSAFEA_UNUSED_VAR(Length);
+  STSAFEA_UNUSED_VAR(InPlace);
   /* In this case the direct pointer assignment allows the best memory optimization.
      But up to the caller to manage this memory content properly, copying it to a local buffer if needed */
   pDestLVBuffer->Data = pSrcLVData;
@@ -2897,8 +3331,16 @@ static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLV
   /* In this case a copy from buffer to buffer is done. It's expected that the
      application have been already allocated the right memory for the pDestLVData.
      Only the expected length of data is copied, but the actual length provided by STSAFE is
-     returned, so up to the application to re-allocate properly and re-try  */
-  if ((Length > 0U) && (pDestLVBuffer->Data != NULL))
+     returned, so up to the application to re-allocate properly and re-try.
+     Without memory allocated, the data is left in place if requested by StSafeA_SetInPlaceResponse */
+  if (pDestLVBuffer->Data == NULL)
+  {
+    if (InPlace != STSAFEA_FLAG_FALSE)
+    {
+      pDestLVBuffer->Data = pSrcLVData;
+    }
+  }
+  else if (Length > 0U)
   {
     (void)memcpy(pDestLVBuffer->Data, pSrcLVData, Length);
   }
@@ -2908,6 +3350,8 @@ static void StSafeA_SetLVData(StSafeA_LVBuffer_t *pDestLVBuffer, uint8_t *pSrcLV
 /**
   * @brief   StSafeA_BuildCommandHeaderCMAC
   *          Static function used to Build the Command Header and set the C-MAC command field.
+  * @note    The Host C-MAC sequence counter is only queried from the STSAFE-A1xx device when the value tracked
+  *          in the handle is unknown, see StSafeA_UpdateHostMacSequenceCounter.
   *
   * @param   pStSafeA    : STSAFE-A1xx object pointer.
   * @param   CommandCode : Command code.
@@ -2921,17 +3365,72 @@ static void StSafeA_BuildCommandHeaderCMAC(StSafeA_Handle_t *pStSafeA, uint8_t C
 #if (STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
     *pMAC = STSAFEA_MAC_NONE;
 #else
-    /* Get CMAC counter value */
-    if ((*pMAC & STSAFEA_CMD_HEADER_SCHN_HOSTEN) != 0x00U)
+    /* Account for the previous Host C-MAC command */
+    if (pStSafeA->HostMacSequenceCounterPending != 0U)
+    {
+      pStSafeA->HostMacSequenceCounterPending = 0U;
+      if (pStSafeA->HostMacSequenceCounter != STSAFEA_HOST_CMAC_INVALID_COUNTER)
+      {
+        pStSafeA->HostMacSequenceCounter++;
+      }
+    }
+
+    /* Get CMAC counter value, if not already known */
+    if (((*pMAC & STSAFEA_CMD_HEADER_SCHN_HOSTEN) != 0x00U) &&
+        (pStSafeA->HostMacSequenceCounter == STSAFEA_HOST_CMAC_INVALID_COUNTER))
     {
       StSafeA_GetHostMacSequenceCounter(pStSafeA);
     }
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
 
     pStSafeA->InOutBuffer.Header = (CommandCode | (*pMAC & STSAFEA_CMD_HEADER_MAC_MSK));
+    STSAFEA_TRACE(&pStSafeA->HwCtx, STSAFEA_TRACE_PHASE_START, pStSafeA->InOutBuffer.Header);
+
+    /* Start the command CRC, completed while the command data is copied, see StSafeA_CopyCommandData */
+    pStSafeA->HwCtx.TxCrcLength = STSAFEA_CRC_NOT_ACCUMULATED;
+    if ((pStSafeA->CrcSupport != 0U) && (pStSafeA->HwCtx.CrcUpdate != NULL))
+    {
+      pStSafeA->HwCtx.TxCrcHeader = pStSafeA->InOutBuffer.Header;
+      pStSafeA->HwCtx.TxCrc = pStSafeA->HwCtx.CrcUpdate(0xFFFFU, NULL, &pStSafeA->HwCtx.TxCrcHeader, 1U);
+      pStSafeA->HwCtx.TxCrcLength = 0U;
+    }
   }
 }
 
+/**
+  * @brief   StSafeA_CopyCommandData
+  *          Static function used to copy a command field into the I/O buffer data, at the given offset.
+  * @note    When the bus layer provides CrcUpdate, the command CRC is accumulated during the copy, so that the
+  *          field is only read once. The bytes written in place since the previous copy are accumulated first,
+  *          so the command fields must not be modified once a following field has been copied.
+  *
+  * @param   pStSafeA    : STSAFE-A1xx object pointer.
+  * @param   Offset      : Offset of the field in the command data.
+  * @param   pData       : Pointer to the field.
+  * @param   Length      : Length of the field in bytes.
+  * @retval  none
+  */
+static void StSafeA_CopyCommandData(StSafeA_Handle_t *pStSafeA, uint16_t Offset, const uint8_t *pData,
+                                    uint16_t Length)
+{
+  STSAFEA_HW_t *p_hw = &pStSafeA->HwCtx;
+  uint8_t *p_data = pStSafeA->InOutBuffer.LV.Data;
+
+  STSAFEA_PROFILE_BEGIN(p_hw, STSAFEA_PROFILE_COPY);
+  if ((p_hw->CrcUpdate != NULL) && (p_hw->TxCrcLength != STSAFEA_CRC_NOT_ACCUMULATED) &&
+      (p_hw->TxCrcLength <= Offset))
+  {
+    p_hw->TxCrc = p_hw->CrcUpdate(p_hw->TxCrc, NULL, &p_data[p_hw->TxCrcLength], Offset - p_hw->TxCrcLength);
+    p_hw->TxCrc = p_hw->CrcUpdate(p_hw->TxCrc, &p_data[Offset], pData, Length);
+    p_hw->TxCrcLength = Offset + Length;
+  }
+  else
+  {
+    (void)memcpy(&p_data[Offset], pData, Length);
+  }
+  STSAFEA_PROFILE_END(p_hw, STSAFEA_PROFILE_COPY);
+}
+
 #if (!STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT)
 /**
   * @brief   StSafeA_GetHostMacSequenceCounter
@@ -2954,6 +3453,36 @@ static void StSafeA_GetHostMacSequenceCounter(StSafeA_Handle_t *pStSafeA)
     }
   }
 }
+
+/**
+  * @brief   StSafeA_UpdateHostMacSequenceCounter
+  *          Static function used to track the Host MAC sequence counter of the STSAFE-A1xx device after a command
+  *          has been exchanged, so that it does not have to be queried before each Host C-MAC command.
+  * @note    The STSAFE-A1xx device increments its counter for each Host C-MAC command it processes. The tracked
+  *          value is incremented when the next command is built, as the current value is still needed to
+  *          decrypt the response. On any failure, the device counter state is unknown: the tracked value is
+  *          invalidated and will be queried again before the next Host C-MAC command.
+  *
+  * @param   pStSafeA    : STSAFE-A1xx object pointer.
+  * @param   Header      : Header of the command that was sent.
+  * @param   StatusCode  : Status of the command exchange.
+  * @retval  none
+  */
+static void StSafeA_UpdateHostMacSequenceCounter(StSafeA_Handle_t *pStSafeA, uint8_t Header,
+                                                 StSafeA_ResponseCode_t StatusCode)
+{
+  if ((Header & (uint8_t)STSAFEA_MAC_HOST_CMAC) == (uint8_t)STSAFEA_MAC_HOST_CMAC)
+  {
+    if (StatusCode == STSAFEA_OK)
+    {
+      pStSafeA->HostMacSequenceCounterPending = 1U;
+    }
+    else
+    {
+      pStSafeA->HostMacSequenceCounter = STSAFEA_HOST_CMAC_INVALID_COUNTER;
+    }
+  }
+}
 #endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
 
 /**
@@ -3031,9 +3560,10 @@ StSafeA_ResponseCode_t StSafeA_StartSignatureSession(
       if (pStSafeA->HashObj.HashCtx != NULL)
       {
         /* Wait for the command processing. Then check for the response */
-        StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_START_SESSION);
+        StSafeA_WaitResponse(pStSafeA, STSAFEA_MS_WAIT_TIME_CMD_START_SESSION,
+                             STSAFEA_MS_MIN_WAIT_TIME_CMD_START_SESSION, STSAFEA_FLAG_TRUE);
 
-        status_code = StSafeA_ReceiveResponse(pStSafeA);
+        status_code = StSafeA_ReceiveResponse(pStSafeA, STSAFEA_FLAG_TRUE);
       }
     }
   }
@@ -3093,8 +3623,8 @@ StSafeA_ResponseCode_t StSafeA_GetSignature(
     /* Challenge (challenge might be empty)*/
     if ((pInChallenge != NULL) && (InChallengeSize > 0U))
     {
-      STSAFEA_CHECK_SIZE(InMAC, 0U, InChallengeSize);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[0], pInChallenge, InChallengeSize);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, 0U, InChallengeSize);
+      StSafeA_CopyCommandData(pStSafeA, 0U, pInChallenge, InChallengeSize);
       pStSafeA->InOutBuffer.LV.Length = InChallengeSize;
     }
     else
@@ -3118,20 +3648,22 @@ StSafeA_ResponseCode_t StSafeA_GetSignature(
       pStSafeA->InOutBuffer.LV.Length += STSAFEA_R_MAC_LENGTH(InMAC);
 
       /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_GET_SIGNATURE);
+      StSafeA_WaitResponse(pStSafeA, STSAFEA_MS_WAIT_TIME_CMD_GET_SIGNATURE,
+                           STSAFEA_MS_MIN_WAIT_TIME_CMD_GET_SIGNATURE, STSAFEA_FLAG_TRUE);
 
       /* Read response */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
+      status_code = StSafeA_ReceiveResponse(pStSafeA, STSAFEA_FLAG_TRUE);
 
       if (status_code == STSAFEA_OK)
       {
         /* Assign the received response to the output parameter */
-        status_code = StSafeA_AssignLVBuffer(pOutSignR, &pStSafeA->InOutBuffer.LV.Data[0], InSignRSLen);
+        status_code = StSafeA_AssignLVBuffer(pOutSignR, &pStSafeA->InOutBuffer.LV.Data[0], InSignRSLen,
+                                             pStSafeA->InPlaceResponse);
         if (status_code == STSAFEA_OK)
         {
           status_code = StSafeA_AssignLVBuffer(pOutSignS, &pStSafeA->InOutBuffer.LV.Data[STSAFEA_LENGTH_SIZE + \
                                                                                          pOutSignR->Length], \
-                                               InSignRSLen);
+                                               InSignRSLen, pStSafeA->InPlaceResponse);
         }
       }
     }
@@ -3210,11 +3742,11 @@ StSafeA_ResponseCode_t StSafeA_PublicKeySlotQuery(
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
 
   /* Check null pointers */
-  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)                  &&
-      (pOutPubKeySlot != NULL)                                &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutPubX)     &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutPubY)     &&
-      IS_STSAFEA_CONDITIONAL_LVBUFFER_VALID_PTR(pOutCurveId))
+  if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA)                   &&
+      (pOutPubKeySlot != NULL)                                 &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutPubX) &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutPubY) &&
+      IS_STSAFEA_OUTPUT_LVBUFFER_VALID_PTR(pStSafeA, pOutCurveId))
   {
     /* Check parameters */
     stsafea_assert_param(IS_STSAFEA_MAC(InMAC));
@@ -3227,58 +3759,48 @@ StSafeA_ResponseCode_t StSafeA_PublicKeySlotQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_PUBLIC_KEY_SLOT;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_PUBLIC_KEY_SLOT_QUERY_MIN_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_PUBLIC_KEY_SLOT_QUERY_MIN_RESPONSE_LENGTH
-                                        + STSAFEA_R_MAC_LENGTH(InMAC);
+      uint16_t uIdx = 0;
+      pOutPubKeySlot->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutPubKeySlot->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[uIdx];
+      uIdx++;
 
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
+      if ((pOutPubKeySlot->Length > 1U) && (pOutPubKeySlot->PresenceFlag != 0U))
       {
-        uint16_t uIdx = 0;
-        pOutPubKeySlot->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutPubKeySlot->PresenceFlag = pStSafeA->InOutBuffer.LV.Data[uIdx];
+        /* Assign the PointRepresentationId */
+        pOutPubKeySlot->PointRepresentationId = pStSafeA->InOutBuffer.LV.Data[uIdx];
         uIdx++;
 
-        if ((pOutPubKeySlot->Length > 1U) && (pOutPubKeySlot->PresenceFlag != 0U))
+        /* The following input params are checked here so the API can be called
+           with the following NULL just to check the PresenceFlag */
+        if ((pOutPubX == NULL) || (pOutPubY == NULL) || (pOutCurveId == NULL))
         {
-          /* Assign the PointRepresentationId */
-          pOutPubKeySlot->PointRepresentationId = pStSafeA->InOutBuffer.LV.Data[uIdx];
-          uIdx++;
+          status_code = STSAFEA_INVALID_PARAMETER;
+        }
+        else
+        {
+          /* Assign the PubX Key output parameter */
+          status_code = StSafeA_AssignLVBuffer(pOutPubX, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen,
+                                               pStSafeA->InPlaceResponse);
+          uIdx += (uint16_t)sizeof(pOutPubX->Length) + pOutPubX->Length;
 
-          /* The following input params are checked here so the API can be called
-             with the following NULL just to check the PresenceFlag */
-          if ((pOutPubX == NULL) || (pOutPubY == NULL) || (pOutCurveId == NULL))
+          /* Assign the PubY Key output parameter */
+          if (status_code == STSAFEA_OK)
           {
-            status_code = STSAFEA_INVALID_PARAMETER;
+            status_code = StSafeA_AssignLVBuffer(pOutPubY, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen,
+                                                 pStSafeA->InPlaceResponse);
+            uIdx += (uint16_t)sizeof(pOutPubY->Length) + pOutPubY->Length;
           }
-          else
-          {
-            /* Assign the PubX Key output parameter */
-            status_code = StSafeA_AssignLVBuffer(pOutPubX, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen);
-            uIdx += (uint16_t)sizeof(pOutPubX->Length) + pOutPubX->Length;
-
-            /* Assign the PubY Key output parameter */
-            if (status_code == STSAFEA_OK)
-            {
-              status_code = StSafeA_AssignLVBuffer(pOutPubY, &pStSafeA->InOutBuffer.LV.Data[uIdx], InPubXYLen);
-              uIdx += (uint16_t)sizeof(pOutPubY->Length) + pOutPubY->Length;
-            }
 
-            /* Assign the CurveId output parameter */
-            if (status_code == STSAFEA_OK)
-            {
-              status_code = StSafeA_AssignLVBuffer(pOutCurveId, &pStSafeA->InOutBuffer.LV.Data[uIdx], InCurveIdLen);
-            }
+          /* Assign the CurveId output parameter */
+          if (status_code == STSAFEA_OK)
+          {
+            status_code = StSafeA_AssignLVBuffer(pOutCurveId, &pStSafeA->InOutBuffer.LV.Data[uIdx], InCurveIdLen,
+                                                 pStSafeA->InPlaceResponse);
           }
         }
       }
@@ -3343,10 +3865,10 @@ StSafeA_ResponseCode_t StSafeA_PutPublicKeySlot(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubX->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubX->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubX->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubX->Data,
-                   pInPubX->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubX->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubX->Data,
+                              pInPubX->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubX->Length) + pInPubX->Length;
     }
@@ -3357,28 +3879,16 @@ StSafeA_ResponseCode_t StSafeA_PutPublicKeySlot(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = (uint8_t)((pInPubY->Length & 0xFF00U) >> 8);
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] = (uint8_t)(pInPubY->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubY->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInPubY->Data,
-                   pInPubY->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInPubY->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInPubY->Data,
+                              pInPubY->Length);
 
       pStSafeA->InOutBuffer.LV.Length += (uint16_t)sizeof(pInPubY->Length) + pInPubY->Length;
     }
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
-
-    if (status_code == STSAFEA_OK)
-    {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_PUT_ATTRIBUTE);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-    }
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, 0U, InMAC);
   }
 
   return status_code;
@@ -3433,10 +3943,10 @@ StSafeA_ResponseCode_t StSafeA_VerifyEntitySignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] =
         (uint8_t)(pInRSignature->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInRSignature->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInRSignature->Data,
-                   pInRSignature->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInRSignature->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInRSignature->Data,
+                              pInRSignature->Length);
 
       pStSafeA->InOutBuffer.LV.Length += 2U + pInRSignature->Length;
     }
@@ -3449,34 +3959,22 @@ StSafeA_ResponseCode_t StSafeA_VerifyEntitySignature(
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 1U] =
         (uint8_t)(pInSSignature->Length & 0x00FFU);
 
-      STSAFEA_CHECK_SIZE(InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSSignature->Length);
-      (void)memcpy(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length + 2U],
-                   pInSSignature->Data,
-                   pInSSignature->Length);
+      STSAFEA_CHECK_SIZE(pStSafeA, InMAC, pStSafeA->InOutBuffer.LV.Length + STSAFEA_LENGTH_SIZE, pInSSignature->Length);
+      StSafeA_CopyCommandData(pStSafeA, pStSafeA->InOutBuffer.LV.Length + 2U,
+                              pInSSignature->Data,
+                              pInSSignature->Length);
 
       pStSafeA->InOutBuffer.LV.Length += 2U + pInSSignature->Length;
     }
 
     /* Transmit command */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_VERIFY_ENTITY_SIGNATURE_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_VERIFY_ENTITY_SIGNATURE_RESPONSE_LENGTH + STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_VERIFY_ENTITY_SIGNATURE);
 
-      /* Read response */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
-      {
-
-        pOutRespVerifySignature->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutRespVerifySignature->SignatureValidity = pStSafeA->InOutBuffer.LV.Data[0];
-      }
+      pOutRespVerifySignature->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutRespVerifySignature->SignatureValidity = pStSafeA->InOutBuffer.LV.Data[0];
     }
   }
 
@@ -3558,70 +4056,57 @@ StSafeA_ResponseCode_t StSafeA_CommandAuthorizationConfigurationQuery(
     pStSafeA->InOutBuffer.LV.Data[0] = (uint8_t)STSAFEA_TAG_COMMAND_AUTHORIZATION_CONFIGURATION;
     pStSafeA->InOutBuffer.LV.Length = 1U;
 
-    /* Transmit */
-    status_code = StSafeA_TransmitCommand(pStSafeA);
+    /* Execute command */
+    status_code = StSafeA_ExecuteCommand(pStSafeA, STSAFEA_CMD_AUTH_CONFIG_QUERY_MIN_RESPONSE_LENGTH, InMAC);
 
     if (status_code == STSAFEA_OK)
     {
-      /* Set response length */
-      pStSafeA->InOutBuffer.LV.Length = STSAFEA_CMD_AUTH_CONFIG_QUERY_MIN_RESPONSE_LENGTH +
-                                        STSAFEA_R_MAC_LENGTH(InMAC);
-
-      /* Wait for the command processing. Then check for the response */
-      StSafeA_Delay(STSAFEA_MS_WAIT_TIME_CMD_QUERY);
-
-      /* Receive */
-      status_code = StSafeA_ReceiveResponse(pStSafeA);
-
-      if (status_code == STSAFEA_OK)
+      uint8_t uIdx = 0U;
+      pOutCmdAuthConfig->Length = pStSafeA->InOutBuffer.LV.Length;
+      pOutCmdAuthConfig->ChangeRight = pStSafeA->InOutBuffer.LV.Data[uIdx];
+      uIdx++;
+      pOutCmdAuthConfig->CommandAuthorizationRecordNumber = pStSafeA->InOutBuffer.LV.Data[uIdx];
+      uIdx++;
+
+      if (pOutCmdAuthConfig->CommandAuthorizationRecordNumber > InCmdAuthRecordNum)
+      {
+        /* Return an error so the application can read the correct number of Records,
+           allocate the right space (if not under STSAFEA_USE_OPTIMIZATION_SHARED_RAM optimization),
+           and call back this API with the right InCmdAuthRecordNum parameter */
+        status_code = STSAFEA_INVALID_RESP_LENGTH;
+      }
+      else
       {
-        uint8_t uIdx = 0U;
-        pOutCmdAuthConfig->Length = pStSafeA->InOutBuffer.LV.Length;
-        pOutCmdAuthConfig->ChangeRight = pStSafeA->InOutBuffer.LV.Data[uIdx];
-        uIdx++;
-        pOutCmdAuthConfig->CommandAuthorizationRecordNumber = pStSafeA->InOutBuffer.LV.Data[uIdx];
-        uIdx++;
-
-        if (pOutCmdAuthConfig->CommandAuthorizationRecordNumber > InCmdAuthRecordNum)
-        {
-          /* Return an error so the application can read the correct number of Records,
-             allocate the right space (if not under STSAFEA_USE_OPTIMIZATION_SHARED_RAM optimization),
-             and call back this API with the right InCmdAuthRecordNum parameter */
-          status_code = STSAFEA_INVALID_RESP_LENGTH;
-        }
-        else
-        {
 #if (STSAFEA_USE_OPTIMIZATION_SHARED_RAM)
-          /* In this case the direct pointer assignment allows the best memory optimization.
-             But up to the caller to manage this memory content properly, copying it to a local buffer if needed */
-          pOutCmdAuthConfig->pCommandAuthorizationRecord =
-            (StSafeA_CommandAuthorizationRecordBuffer_t *)&pStSafeA->InOutBuffer.LV.Data[uIdx];
+        /* In this case the direct pointer assignment allows the best memory optimization.
+           But up to the caller to manage this memory content properly, copying it to a local buffer if needed */
+        pOutCmdAuthConfig->pCommandAuthorizationRecord =
+          (StSafeA_CommandAuthorizationRecordBuffer_t *)&pStSafeA->InOutBuffer.LV.Data[uIdx];
 #else
-          /* In this case a copy from buffer to buffer is done. It's expected that the
-            application have been already allocated right memory for the StSafeA_CommandAuthorizationRecordBuffer[] */
-          if (pOutCmdAuthConfig->CommandAuthorizationRecordNumber > 0U)
+        /* In this case a copy from buffer to buffer is done. It's expected that the
+          application have been already allocated right memory for the StSafeA_CommandAuthorizationRecordBuffer[] */
+        if (pOutCmdAuthConfig->CommandAuthorizationRecordNumber > 0U)
+        {
+          if (pOutCmdAuthConfig->pCommandAuthorizationRecord != NULL)
           {
-            if (pOutCmdAuthConfig->pCommandAuthorizationRecord != NULL)
+            uint8_t record_max_len = (uint8_t)sizeof(StSafeA_CommandAuthorizationRecordBuffer_t);
+            for (uint8_t i = 0; i < pOutCmdAuthConfig->CommandAuthorizationRecordNumber; i++)
             {
-              uint8_t record_max_len = (uint8_t)sizeof(StSafeA_CommandAuthorizationRecordBuffer_t);
-              for (uint8_t i = 0; i < pOutCmdAuthConfig->CommandAuthorizationRecordNumber; i++)
-              {
-                pOutCmdAuthConfig->pCommandAuthorizationRecord[i].CommandCode =
-                  pStSafeA->InOutBuffer.LV.Data[uIdx];
-                pOutCmdAuthConfig->pCommandAuthorizationRecord[i].CommandAC =
-                  pStSafeA->InOutBuffer.LV.Data[uIdx + 1U];
-                pOutCmdAuthConfig->pCommandAuthorizationRecord[i].HostEncryptionFlags =
-                  pStSafeA->InOutBuffer.LV.Data[uIdx + 2U];
-                uIdx += record_max_len;
-              }
-            }
-            else
-            {
-              status_code = STSAFEA_INVALID_PARAMETER;
+              pOutCmdAuthConfig->pCommandAuthorizationRecord[i].CommandCode =
+                pStSafeA->InOutBuffer.LV.Data[uIdx];
+              pOutCmdAuthConfig->pCommandAuthorizationRecord[i].CommandAC =
+                pStSafeA->InOutBuffer.LV.Data[uIdx + 1U];
+              pOutCmdAuthConfig->pCommandAuthorizationRecord[i].HostEncryptionFlags =
+                pStSafeA->InOutBuffer.LV.Data[uIdx + 2U];
+              uIdx += record_max_len;
             }
           }
-#endif /* STSAFEA_USE_OPTIMIZATION_SHARED_RAM */
+          else
+          {
+            status_code = STSAFEA_INVALID_PARAMETER;
+          }
         }
+#endif /* STSAFEA_USE_OPTIMIZATION_SHARED_RAM */
       }
     }
   }
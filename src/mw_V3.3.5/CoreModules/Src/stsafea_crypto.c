@@ -24,6 +24,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stsafea_crypto.h"
+#include "stsafea_service.h"
 #include <string.h>
 
 /** MISRA C:2012 deviation rule has been granted for following rules:
@@ -82,15 +83,6 @@ typedef enum
 /* Private macros ------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
-/** @addtogroup CRYPTO_Private_Variables
-  * @{
-  */
-static void *pAesRMacCtx = NULL;
-static uint8_t aRMacBuffer[16];
-static uint8_t RMacBufferSize;
-/**
-  * @}
-  */
 
 
 /* Global variables ----------------------------------------------------------*/
@@ -153,28 +145,31 @@ void StSafeA_ComputeCMAC(StSafeA_Handle_t *pStSafeA)
   {
     uint8_t host_mac_computation = pStSafeA->InOutBuffer.Header & (uint8_t)STSAFEA_CMD_HEADER_SCHN_HOSTEN;
     void *p_aes_cmac_ctx = NULL;
+    StSafeA_RMac_t *p_rmac = &pStSafeA->RMacObj;
 
     uint16_t length;
 
+    STSAFEA_PROFILE_BEGIN(&pStSafeA->HwCtx, STSAFEA_PROFILE_CMAC);
+
     /* C-MAC computation */
     StSafeA_AES_MAC_Start(&p_aes_cmac_ctx);
 
     /* Compute IV for Host C-MAC */
     if (host_mac_computation != 0U)
     {
-      ComputeInitialValue(pStSafeA, CMAC_COMPUTATION, aRMacBuffer);
-      StSafeA_AES_MAC_Update(aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_aes_cmac_ctx);
+      ComputeInitialValue(pStSafeA, CMAC_COMPUTATION, p_rmac->aRMacBuffer);
+      StSafeA_AES_MAC_Update(p_rmac->aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_aes_cmac_ctx);
     }
 
     /* Payload  */
     length = pStSafeA->InOutBuffer.LV.Length;
 
-    aRMacBuffer[0] = (host_mac_computation == 0U) ? ((uint8_t)pStSafeA->MacCounter & 0x7FU) : 0x00U;
-    StSafeA_Copy_TLVBuffer(&aRMacBuffer[1], &pStSafeA->InOutBuffer, STSAFEA_MAC_PACKET_SIZE - 1U);
+    p_rmac->aRMacBuffer[0] = (host_mac_computation == 0U) ? ((uint8_t)pStSafeA->MacCounter & 0x7FU) : 0x00U;
+    StSafeA_Copy_TLVBuffer(&p_rmac->aRMacBuffer[1], &pStSafeA->InOutBuffer, STSAFEA_MAC_PACKET_SIZE - 1U);
 
     if (length > (STSAFEA_MAC_PACKET_SIZE - (uint16_t)STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE))
     {
-      StSafeA_AES_MAC_Update(aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_aes_cmac_ctx);
+      StSafeA_AES_MAC_Update(p_rmac->aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_aes_cmac_ctx);
 
       StSafeA_AES_MAC_LastUpdate(&pStSafeA->InOutBuffer.LV.Data[STSAFEA_MAC_PACKET_SIZE -
                                                                 STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE],
@@ -184,7 +179,8 @@ void StSafeA_ComputeCMAC(StSafeA_Handle_t *pStSafeA)
     }
     else
     {
-      StSafeA_AES_MAC_LastUpdate(aRMacBuffer, length + (uint16_t)STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE,
+      StSafeA_AES_MAC_LastUpdate(p_rmac->aRMacBuffer,
+                                 length + (uint16_t)STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE,
                                  p_aes_cmac_ctx);
     }
 
@@ -193,45 +189,47 @@ void StSafeA_ComputeCMAC(StSafeA_Handle_t *pStSafeA)
     /* R-MAC computation */
     if ((pStSafeA->InOutBuffer.Header & (uint8_t)STSAFEA_CMD_HEADER_RMACEN) == (uint8_t)STSAFEA_CMD_HEADER_RMACEN)
     {
-      pAesRMacCtx = NULL;
-      RMacBufferSize = 0;
+      p_rmac->pAesRMacCtx = NULL;
+      p_rmac->RMacBufferSize = 0;
 
-      StSafeA_AES_MAC_Start(&pAesRMacCtx);
+      StSafeA_AES_MAC_Start(&p_rmac->pAesRMacCtx);
 
       /* Compute IV for Host R-MAC */
       if (host_mac_computation != 0U)
       {
-        ComputeInitialValue(pStSafeA, RMAC_COMPUTATION, aRMacBuffer);
-        StSafeA_AES_MAC_Update(aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, pAesRMacCtx);
+        ComputeInitialValue(pStSafeA, RMAC_COMPUTATION, p_rmac->aRMacBuffer);
+        StSafeA_AES_MAC_Update(p_rmac->aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_rmac->pAesRMacCtx);
       }
 
       /* C-MAC computation */
-      aRMacBuffer[0] = (host_mac_computation == 0U) ? ((pStSafeA->MacCounter + 1U) | 0x80U) : 0x80U;
-      StSafeA_Copy_TLVBuffer(&aRMacBuffer[1], &pStSafeA->InOutBuffer, STSAFEA_MAC_PACKET_SIZE - 1U);
+      p_rmac->aRMacBuffer[0] = (host_mac_computation == 0U) ? ((pStSafeA->MacCounter + 1U) | 0x80U) : 0x80U;
+      StSafeA_Copy_TLVBuffer(&p_rmac->aRMacBuffer[1], &pStSafeA->InOutBuffer, STSAFEA_MAC_PACKET_SIZE - 1U);
 
       if (length > (STSAFEA_MAC_PACKET_SIZE - STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE))
       {
-        StSafeA_AES_MAC_Update(aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, pAesRMacCtx);
+        StSafeA_AES_MAC_Update(p_rmac->aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_rmac->pAesRMacCtx);
 
         StSafeA_AES_MAC_Update(&pStSafeA->InOutBuffer.LV.Data[STSAFEA_MAC_PACKET_SIZE -
                                                               STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE],
                                ((uint16_t)(((uint32_t)length - STSAFEA_MAC_PACKET_SIZE +
                                             STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE) / STSAFEA_MAC_PACKET_SIZE)) *
                                STSAFEA_MAC_PACKET_SIZE,
-                               pAesRMacCtx);
+                               p_rmac->pAesRMacCtx);
 
-        RMacBufferSize = (uint8_t)((uint32_t)length - STSAFEA_MAC_PACKET_SIZE +
-                                   STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE) %
-                         STSAFEA_MAC_PACKET_SIZE;
-        (void)memcpy(aRMacBuffer, &pStSafeA->InOutBuffer.LV.Data[length - RMacBufferSize], RMacBufferSize);
+        p_rmac->RMacBufferSize = (uint8_t)((uint32_t)length - STSAFEA_MAC_PACKET_SIZE +
+                                           STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE) %
+                                 STSAFEA_MAC_PACKET_SIZE;
+        (void)memcpy(p_rmac->aRMacBuffer, &pStSafeA->InOutBuffer.LV.Data[length - p_rmac->RMacBufferSize],
+                     p_rmac->RMacBufferSize);
       }
       else
       {
-        RMacBufferSize = (uint8_t)(length + STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE);
+        p_rmac->RMacBufferSize = (uint8_t)(length + STSAFEA_KNOWN_INPUT_TO_CMAC_COMPUTATION_SIZE);
       }
     }
 
     pStSafeA->InOutBuffer.LV.Length += STSAFEA_MAC_LENGTH;
+    STSAFEA_PROFILE_END(&pStSafeA->HwCtx, STSAFEA_PROFILE_CMAC);
   }
 }
 
@@ -247,30 +245,36 @@ void StSafeA_ComputeRMAC(StSafeA_Handle_t *pStSafeA)
   if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
   {
     uint16_t length = pStSafeA->InOutBuffer.LV.Length;
+    StSafeA_RMac_t *p_rmac = &pStSafeA->RMacObj;
 
-    StSafeA_Copy_TLVBuffer(&aRMacBuffer[RMacBufferSize], &pStSafeA->InOutBuffer,
-                           STSAFEA_MAC_PACKET_SIZE - (uint16_t)RMacBufferSize);
+    STSAFEA_PROFILE_BEGIN(&pStSafeA->HwCtx, STSAFEA_PROFILE_RMAC);
+    StSafeA_Copy_TLVBuffer(&p_rmac->aRMacBuffer[p_rmac->RMacBufferSize], &pStSafeA->InOutBuffer,
+                           STSAFEA_MAC_PACKET_SIZE - (uint16_t)p_rmac->RMacBufferSize);
 
-    if ((length + RMacBufferSize) > (uint16_t)(STSAFEA_MAC_PACKET_SIZE - STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE))
+    if ((length + p_rmac->RMacBufferSize) >
+        (uint16_t)(STSAFEA_MAC_PACKET_SIZE - STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE))
     {
-      StSafeA_AES_MAC_Update(aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, pAesRMacCtx);
+      StSafeA_AES_MAC_Update(p_rmac->aRMacBuffer, STSAFEA_MAC_PACKET_SIZE, p_rmac->pAesRMacCtx);
 
-      StSafeA_AES_MAC_LastUpdate(&pStSafeA->InOutBuffer.LV.Data[(uint32_t)STSAFEA_MAC_PACKET_SIZE - RMacBufferSize -
+      StSafeA_AES_MAC_LastUpdate(&pStSafeA->InOutBuffer.LV.Data[(uint32_t)STSAFEA_MAC_PACKET_SIZE -
+                                                                p_rmac->RMacBufferSize -
                                                                 STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE],
-                                 length + RMacBufferSize - STSAFEA_MAC_PACKET_SIZE +
+                                 length + p_rmac->RMacBufferSize - STSAFEA_MAC_PACKET_SIZE +
                                  (uint16_t)STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE,
-                                 pAesRMacCtx);
+                                 p_rmac->pAesRMacCtx);
     }
     else
     {
-      StSafeA_AES_MAC_LastUpdate(aRMacBuffer,
-                                 length + RMacBufferSize + (uint16_t)STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE,
-                                 pAesRMacCtx);
+      StSafeA_AES_MAC_LastUpdate(p_rmac->aRMacBuffer,
+                                 length + p_rmac->RMacBufferSize +
+                                 (uint16_t)STSAFEA_KNOWN_INPUT_TO_RMAC_COMPUTATION_SIZE,
+                                 p_rmac->pAesRMacCtx);
     }
 
-    StSafeA_AES_MAC_Final(&pStSafeA->InOutBuffer.LV.Data[length], &pAesRMacCtx);
+    StSafeA_AES_MAC_Final(&pStSafeA->InOutBuffer.LV.Data[length], &p_rmac->pAesRMacCtx);
 
     pStSafeA->InOutBuffer.LV.Length += STSAFEA_MAC_LENGTH;
+    STSAFEA_PROFILE_END(&pStSafeA->HwCtx, STSAFEA_PROFILE_RMAC);
   }
 }
 
@@ -289,14 +293,17 @@ StSafeA_ResponseCode_t StSafeA_DataEncryption(StSafeA_Handle_t *pStSafeA)
   if (IS_STSAFEA_HANDLER_VALID_PTR(pStSafeA))
   {
     uint8_t initial_value[STSAFEA_INITIAL_VALUE_SIZE];
+
+    STSAFEA_PROFILE_BEGIN(&pStSafeA->HwCtx, STSAFEA_PROFILE_ENCRYPTION);
     /* Compute initial value */
     ComputeInitialValue(pStSafeA, C_ENCRYPTION, initial_value);
     status_code = ((StSafeA_AES_ECB_Encrypt(initial_value, initial_value,
                                             STSAFEA_KEY_TYPE_AES_128) == 0) ? STSAFEA_OK : STSAFEA_CRYPTO_LIB_ISSUE);
 
-    /* Encrypt data */
+    /* Encrypt data, the CRC accumulated over the plain data no longer applies */
     if (status_code == STSAFEA_OK)
     {
+      pStSafeA->HwCtx.TxCrcLength = STSAFEA_CRC_NOT_ACCUMULATED;
       pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length] = 0x80;
       pStSafeA->InOutBuffer.LV.Length++;
       padding_length = STSAFEA_HOST_SECURE_CHANNEL_MODULUS -
@@ -312,6 +319,7 @@ StSafeA_ResponseCode_t StSafeA_DataEncryption(StSafeA_Handle_t *pStSafeA)
                                              initial_value,
                                              STSAFEA_KEY_TYPE_AES_128) == 0) ? STSAFEA_OK : STSAFEA_CRYPTO_LIB_ISSUE;
     }
+    STSAFEA_PROFILE_END(&pStSafeA->HwCtx, STSAFEA_PROFILE_ENCRYPTION);
   }
   return status_code;
 }
@@ -332,6 +340,7 @@ StSafeA_ResponseCode_t StSafeA_DataDecryption(StSafeA_Handle_t *pStSafeA)
   {
     uint8_t initial_value[STSAFEA_INITIAL_VALUE_SIZE];
 
+    STSAFEA_PROFILE_BEGIN(&pStSafeA->HwCtx, STSAFEA_PROFILE_DECRYPTION);
     /* Compute initial value */
     ComputeInitialValue(pStSafeA, R_ENCRYPTION, initial_value);
     status_code = ((StSafeA_AES_ECB_Encrypt(initial_value, initial_value,
@@ -351,11 +360,11 @@ StSafeA_ResponseCode_t StSafeA_DataDecryption(StSafeA_Handle_t *pStSafeA)
         p_padding = StSafeA_Memrchr(&pStSafeA->InOutBuffer.LV.Data[0], 0x80,
                                     pStSafeA->InOutBuffer.LV.Length);
 
-        uint32_t padding_pos = (uint32_t)&p_padding[0];
-        uint32_t buffer_pos  = (uint32_t)&pStSafeA->InOutBuffer.LV.Data[0];
+        uintptr_t padding_pos = (uintptr_t)&p_padding[0];
+        uintptr_t buffer_pos  = (uintptr_t)&pStSafeA->InOutBuffer.LV.Data[0];
         uint16_t new_length  = (uint16_t)(padding_pos - buffer_pos);
         if ((p_padding == NULL) ||
-            (padding_pos > (uint32_t)(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length - 1U])) ||
+            (padding_pos > (uintptr_t)(&pStSafeA->InOutBuffer.LV.Data[pStSafeA->InOutBuffer.LV.Length - 1U])) ||
             (new_length < (pStSafeA->InOutBuffer.LV.Length - (uint16_t)(STSAFEA_HOST_SECURE_CHANNEL_MODULUS))))
         {
           status_code = STSAFEA_CRYPTO_LIB_ISSUE;
@@ -366,6 +375,7 @@ StSafeA_ResponseCode_t StSafeA_DataDecryption(StSafeA_Handle_t *pStSafeA)
         }
       }
     }
+    STSAFEA_PROFILE_END(&pStSafeA->HwCtx, STSAFEA_PROFILE_DECRYPTION);
   }
 
   return status_code;
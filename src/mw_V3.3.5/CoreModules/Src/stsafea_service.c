@@ -38,6 +38,15 @@
   */
 
 /* Private typedef -----------------------------------------------------------*/
+/* Attempts state of a bus phase, see StSafeA_RetryWait */
+typedef struct
+{
+  uint32_t Delay;                      /* Next delay in ms */
+  uint32_t Elapsed;                    /* Time in ms spent delaying the bus phase */
+  uint32_t BusyPollStart;              /* TimeGetUs value at the start of the bus phase */
+  uint16_t Attempts;                   /* Number of failed attempts, not reset by StSafeA_RetryStart */
+} StSafeA_RetryState_t;
+
 /* Private define ------------------------------------------------------------*/
 /** @addtogroup SERVICE_Private_Constants
   * @{
@@ -52,29 +61,53 @@
 #ifndef STSAFEA_I2C_POLLING_STEP
 #define STSAFEA_I2C_POLLING_STEP                3U
 #endif
+
+/* I2C response polling step in ms, used when STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING is set */
+#ifndef STSAFEA_I2C_RESPONSE_POLLING_STEP
+#define STSAFEA_I2C_RESPONSE_POLLING_STEP       1U
+#endif
+
+/* I2C polling step in ms while waiting for a response */
+#if (STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING)
+#define STSAFEA_I2C_RECEIVE_POLLING_STEP        STSAFEA_I2C_RESPONSE_POLLING_STEP
+#else
+#define STSAFEA_I2C_RECEIVE_POLLING_STEP        STSAFEA_I2C_POLLING_STEP
+#endif /* STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING */
 /**
   * @}
   */
 
 
 /* Private macro -------------------------------------------------------------*/
+/* Add to a counter of the command being transmitted/received */
+#if (STSAFEA_USE_STATISTICS)
+#define STSAFEA_STATS_ADD(pHwCtx, Counter, Value)  ((pHwCtx)->Stats[(pHwCtx)->StatsCmd].Counter += (uint32_t)(Value))
+#else
+#define STSAFEA_STATS_ADD(pHwCtx, Counter, Value)  ((void)0U)
+#endif /* STSAFEA_USE_STATISTICS */
+
+/* Memory barrier ordering the trace entries and the ring indexes */
+#if (STSAFEA_USE_TRACE)
+#if defined ( __GNUC__ ) || defined ( __ARMCC_VERSION )
+#define STSAFEA_TRACE_BARRIER()    __sync_synchronize()
+#else
+#define STSAFEA_TRACE_BARRIER()    ((void)0U)
+#endif /* __GNUC__ __ARMCC_VERSION */
+#endif /* STSAFEA_USE_TRACE */
 
 /* Private variables ---------------------------------------------------------*/
-/** @addtogroup SERVICE_Private_Variables
-  * @{
-  */
-static STSAFEA_HW_t HwCtx;
-/**
-  * @}
-  */
 
 
 /* Global variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
-static int8_t   StSafeA_SendBytes(StSafeA_TLVBuffer_t *pInBuffer);
-static int8_t   StSafeA_ReceiveBytes(StSafeA_TLVBuffer_t *pOutBuffer);
-static void     StSafeA_Crc16(StSafeA_TLVBuffer_t *pTLV_Buffer);
+static int8_t   StSafeA_SendBytes(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pInBuffer);
+static int8_t   StSafeA_ReceiveBytes(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pOutBuffer, uint16_t *pCrc);
+static void     StSafeA_Crc16(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer);
+static void     StSafeA_CommandCrc16(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer);
+static void     StSafeA_RetryStart(STSAFEA_HW_t *pHwCtx, StSafeA_RetryState_t *pRetry, uint32_t PollingStep);
+static int8_t   StSafeA_RetryWait(STSAFEA_HW_t *pHwCtx, StSafeA_RetryState_t *pRetry);
+static void     StSafeA_UpdateTimeLeft(STSAFEA_HW_t *pHwCtx);
 
 /* Functions Definition ------------------------------------------------------*/
 /** @addtogroup SERVICE_Exported_Functions
@@ -99,20 +132,28 @@ static void     StSafeA_Crc16(StSafeA_TLVBuffer_t *pTLV_Buffer);
   * @note   No other Service APIs can be called/used if this one has never been successfully called first.
   *         The StSafeA_HW_Probe function must have been implemented at service interface layer.
   *
-  * @param  None
+  * @param  pHwCtx : Hardware context to be filled by StSafeA_HW_Probe. pHwCtx->pBusCtx and pHwCtx->DevAddr
+  *                  can be preset to select the device, NULL and 0 to let StSafeA_HW_Probe choose the default.
   * @retval 0 if success, an error code otherwise.
   */
-int8_t StSafeA_HW_Init(void)
+int8_t StSafeA_HW_Init(STSAFEA_HW_t *pHwCtx)
 {
-  int8_t ret = StSafeA_HW_Probe(&HwCtx);
-
-  if ((HwCtx.IOInit == NULL) ||
-      (HwCtx.BusInit == NULL) ||
-      (HwCtx.BusSend == NULL) ||
-      (HwCtx.BusRecv == NULL) ||
-      (HwCtx.CrcInit == NULL) ||
-      (HwCtx.CrcCompute == NULL) ||
-      (HwCtx.TimeDelay == NULL))
+  int8_t ret;
+
+  if (pHwCtx == NULL)
+  {
+    return STSAFEA_BUS_ERR;
+  }
+
+  ret = StSafeA_HW_Probe(pHwCtx);
+
+  if ((pHwCtx->IOInit == NULL) ||
+      (pHwCtx->BusInit == NULL) ||
+      (pHwCtx->BusSend == NULL) ||
+      (pHwCtx->BusRecv == NULL) ||
+      (pHwCtx->CrcInit == NULL) ||
+      (pHwCtx->CrcCompute == NULL) ||
+      (pHwCtx->TimeDelay == NULL))
   {
     return STSAFEA_BUS_ERR;
   }
@@ -120,19 +161,19 @@ int8_t StSafeA_HW_Init(void)
   if (STSAFEA_BUS_OK == ret)
   {
     /* Initialize the STSAFE-A  IO */
-    ret = HwCtx.IOInit();
+    ret = pHwCtx->IOInit(pHwCtx->pBusCtx);
   }
 
   if (STSAFEA_BUS_OK == ret)
   {
     /* Initialize the STSAFE-A communication Bus */
-    ret = HwCtx.BusInit();
+    ret = pHwCtx->BusInit(pHwCtx->pBusCtx);
   }
 
   if (STSAFEA_BUS_OK == ret)
   {
     /* Initialize the STSAFE-A CRC */
-    ret = HwCtx.CrcInit();
+    ret = pHwCtx->CrcInit();
   }
 
   return ret;
@@ -160,22 +201,35 @@ int8_t StSafeA_HW_Init(void)
   *          Prepare the command to be transmitted and call the low level bus to execute.
   *          Compute and concatenate CRC if supported.
   *
+  * @note    The frame is built in place: pTLV_Buffer->LV.Data must be preceded by STSAFEA_BUFFER_HEADROOM_SIZE
+  *          bytes of headroom, as the StSafeA_Handle_t.InOutBuffer set up by StSafeA_Init.
+  *
+  * @param   pHwCtx      : Hardware context of the device.
   * @param   pTLV_Buffer : Tag-Length-Value structure pointer to be transmitted over the bus.
   * @param   CrcSupport  : 0 if CRC is not supported, any other values otherwise.
   * @retval  STSAFEA_OK if success,  an error code otherwise.
   */
-StSafeA_ResponseCode_t StSafeA_Transmit(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_t CrcSupport)
+StSafeA_ResponseCode_t StSafeA_Transmit(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_t CrcSupport)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
-  if (pTLV_Buffer != NULL)
+  if ((pHwCtx != NULL) && (pTLV_Buffer != NULL))
   {
+#if (STSAFEA_USE_STATISTICS)
+    /* The response header overwrites the command one, the command code is kept for the whole exchange */
+    pHwCtx->StatsCmd = pTLV_Buffer->Header & STSAFEA_CMD_HEADER_CODE_MSK;
+#endif /* STSAFEA_USE_STATISTICS */
+    STSAFEA_STATS_ADD(pHwCtx, Commands, 1U);
+
     /* Compute & concatenate CRC to buffer */
     if (CrcSupport != 0U)
     {
-      StSafeA_Crc16(pTLV_Buffer);
+      STSAFEA_PROFILE_BEGIN(pHwCtx, STSAFEA_PROFILE_CRC);
+      StSafeA_CommandCrc16(pHwCtx, pTLV_Buffer);
+      STSAFEA_PROFILE_END(pHwCtx, STSAFEA_PROFILE_CRC);
+      STSAFEA_TRACE(pHwCtx, STSAFEA_TRACE_PHASE_CRC, 0U);
     }
 
-    status_code = (StSafeA_ResponseCode_t)StSafeA_SendBytes(pTLV_Buffer);
+    status_code = (StSafeA_ResponseCode_t)StSafeA_SendBytes(pHwCtx, pTLV_Buffer);
 
     if (status_code != STSAFEA_BUFFER_LENGTH_EXCEEDED)
     {
@@ -187,6 +241,10 @@ StSafeA_ResponseCode_t StSafeA_Transmit(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8
       {
         status_code = STSAFEA_COMMUNICATION_NACK;
       }
+      else if (status_code == (StSafeA_ResponseCode_t)STSAFEA_BUS_TIMEOUT)
+      {
+        status_code = STSAFEA_COMMUNICATION_TIMEOUT;
+      }
       else
       {
         status_code = STSAFEA_COMMUNICATION_ERROR;
@@ -202,15 +260,17 @@ StSafeA_ResponseCode_t StSafeA_Transmit(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8
   *          Receive data from STSAFE-A1xx  using the low level bus functions to retrieve it.
   *          Check the CRC, if supported.
   *
+  * @param   pHwCtx      : Hardware context of the device.
   * @param   pTLV_Buffer : Tag-Length-Value structure pointer to be filled  with received data
   * @param   CrcSupport  : 0 if CRC is not supported, any other values otherwise.
   * @retval  STSAFEA_OK if success,  an error code otherwise.
   */
-StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_t CrcSupport)
+StSafeA_ResponseCode_t StSafeA_Receive(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_t CrcSupport)
 {
   StSafeA_ResponseCode_t status_code = STSAFEA_INVALID_PARAMETER;
+  uint16_t rx_crc = 0;
 
-  if (pTLV_Buffer != NULL)
+  if ((pHwCtx != NULL) && (pTLV_Buffer != NULL))
   {
     /* Increase buffer size in case of CRC */
     if (CrcSupport != 0U)
@@ -218,7 +278,8 @@ StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_
       pTLV_Buffer->LV.Length += STSAFEA_CRC_LENGTH;
     }
 
-    status_code = (StSafeA_ResponseCode_t)StSafeA_ReceiveBytes(pTLV_Buffer);
+    status_code = (StSafeA_ResponseCode_t)StSafeA_ReceiveBytes(pHwCtx, pTLV_Buffer,
+                                                               (CrcSupport != 0U) ? &rx_crc : NULL);
 
     if (status_code != STSAFEA_BUFFER_LENGTH_EXCEEDED)
     {
@@ -231,6 +292,10 @@ StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_
       {
         status_code = STSAFEA_COMMUNICATION_NACK;
       }
+      else if (status_code == (StSafeA_ResponseCode_t)STSAFEA_BUS_TIMEOUT)
+      {
+        status_code = STSAFEA_COMMUNICATION_TIMEOUT;
+      }
       else
       {
         status_code = STSAFEA_COMMUNICATION_ERROR;
@@ -241,19 +306,33 @@ StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_
     if ((CrcSupport != 0U) && (status_code == STSAFEA_OK))
     {
       uint16_t crc;
+      STSAFEA_PROFILE_BEGIN(pHwCtx, STSAFEA_PROFILE_CRC);
       pTLV_Buffer->LV.Length -= STSAFEA_CRC_LENGTH;
       (void)memcpy(&crc, &pTLV_Buffer->LV.Data[pTLV_Buffer->LV.Length], sizeof(crc));
-      StSafeA_Crc16(pTLV_Buffer);
+      if (pHwCtx->BusRecvFrame != NULL)
+      {
+        /* The CRC has been accumulated by the bus layer while the frame was received */
+        uint16_t crc16 = (uint16_t)(SWAP2BYTES(rx_crc) ^ 0xFFFFU);
+        (void)memcpy(&pTLV_Buffer->LV.Data[pTLV_Buffer->LV.Length], &crc16, sizeof(crc16));
+        pTLV_Buffer->LV.Length += STSAFEA_CRC_LENGTH;
+      }
+      else
+      {
+        StSafeA_Crc16(pHwCtx, pTLV_Buffer);
+      }
 
       if (memcmp(&crc, &pTLV_Buffer->LV.Data[pTLV_Buffer->LV.Length - (uint16_t)2],
                  sizeof(crc)) != 0)
       {
         status_code = STSAFEA_INVALID_CRC;
+        STSAFEA_STATS_ADD(pHwCtx, CrcErrors, 1U);
       }
       else
       {
         pTLV_Buffer->LV.Length -= STSAFEA_CRC_LENGTH;
       }
+      STSAFEA_PROFILE_END(pHwCtx, STSAFEA_PROFILE_CRC);
+      STSAFEA_TRACE(pHwCtx, STSAFEA_TRACE_PHASE_CRC_CHECK, 0U);
     }
   }
 
@@ -263,18 +342,166 @@ StSafeA_ResponseCode_t StSafeA_Receive(StSafeA_TLVBuffer_t *pTLV_Buffer,  uint8_
 /**
   * @brief   StSafeA_Delay
   *          Provide a delay in milliseconds.
+  * @note    The delay is shortened to the time left to the current command, see STSAFEA_HW_t.Deadline.
   *
+  * @param   pHwCtx  : Hardware context of the device.
   * @param   msDelay : desired delay in milliseconds.
   * @retval  None
   */
-void StSafeA_Delay(uint32_t msDelay)
+void StSafeA_Delay(STSAFEA_HW_t *pHwCtx, uint32_t msDelay)
 {
   /* Redirect to the TimeDelay function that has been assigned into the HW Context */
-  if (HwCtx.TimeDelay != NULL)
+  if ((pHwCtx != NULL) && (pHwCtx->TimeDelay != NULL))
   {
-    HwCtx.TimeDelay(msDelay);
+    StSafeA_UpdateTimeLeft(pHwCtx);
+    if (pHwCtx->TimeLeft != STSAFEA_NO_DEADLINE)
+    {
+      msDelay = (msDelay < pHwCtx->TimeLeft) ? msDelay : pHwCtx->TimeLeft;
+      if (pHwCtx->TimeGetUs == NULL)
+      {
+        /* No time base: account the requested delays only */
+        pHwCtx->TimeLeft -= msDelay;
+      }
+    }
+
+    STSAFEA_STATS_ADD(pHwCtx, WaitTime, msDelay);
+    if (pHwCtx->BusDelay != NULL)
+    {
+      pHwCtx->BusDelay(pHwCtx->pBusCtx, msDelay);
+    }
+    else
+    {
+      pHwCtx->TimeDelay(msDelay);
+    }
   }
 }
+
+/**
+  * @brief   StSafeA_GetResponsePollingTime
+  *          Return the time spent polling the STSAFE-A1xx device before the last received response was available.
+  * @note    This is the time spent delaying the NACKed response readings, 0 if the response was already
+  *          available at the first reading or during the busy polling of the retry policy.
+  *
+  * @param   pHwCtx : Hardware context of the device.
+  * @retval  Polling time in milliseconds.
+  */
+uint32_t StSafeA_GetResponsePollingTime(STSAFEA_HW_t *pHwCtx)
+{
+  return (pHwCtx != NULL) ? pHwCtx->ResponsePollingTime : 0U;
+}
+
+#if (STSAFEA_USE_PROFILING)
+/**
+  * @brief   StSafeA_ProfileBegin
+  *          Start measuring the host processing time of a section.
+  * @note    STSAFEA_PROFILE_BEGIN should be used instead, so that the call is compiled out with
+  *          STSAFEA_USE_PROFILING = 0. A section must not be nested in itself.
+  *
+  * @param   pHwCtx  : Hardware context of the device.
+  * @param   Section : StSafeA_ProfileSection_t of the section.
+  * @retval  None
+  */
+void StSafeA_ProfileBegin(STSAFEA_HW_t *pHwCtx, uint8_t Section)
+{
+  pHwCtx->Profile.Section[Section].Start = (pHwCtx->CycleCount != NULL) ? pHwCtx->CycleCount() : 0U;
+}
+
+/**
+  * @brief   StSafeA_ProfileEnd
+  *          Account for the host processing time of a section started with StSafeA_ProfileBegin.
+  *
+  * @param   pHwCtx  : Hardware context of the device.
+  * @param   Section : StSafeA_ProfileSection_t of the section.
+  * @retval  None
+  */
+void StSafeA_ProfileEnd(STSAFEA_HW_t *pHwCtx, uint8_t Section)
+{
+  StSafeA_ProfileCounter_t *p_counter = &pHwCtx->Profile.Section[Section];
+  uint32_t cycles = (pHwCtx->CycleCount != NULL) ? (pHwCtx->CycleCount() - p_counter->Start) : 0U;
+
+  p_counter->Calls++;
+  p_counter->Cycles += cycles;
+  if (cycles > p_counter->MaxCycles)
+  {
+    p_counter->MaxCycles = cycles;
+  }
+}
+#endif /* STSAFEA_USE_PROFILING */
+
+#if (STSAFEA_USE_TRACE)
+/**
+  * @brief   StSafeA_TraceRecord
+  *          Record the end of a command phase in the trace ring of the device, dropping it if the ring is full.
+  * @note    Must only be called by the thread operating the device. STSAFEA_TRACE should be used instead, so that
+  *          the call is compiled out with STSAFEA_USE_TRACE = 0.
+  *
+  * @param   pHwCtx : Hardware context of the device.
+  * @param   Phase  : StSafeA_TracePhase_t of the ended phase.
+  * @param   Value  : Phase dependent value, the command header for STSAFEA_TRACE_PHASE_START.
+  * @retval  None
+  */
+void StSafeA_TraceRecord(STSAFEA_HW_t *pHwCtx, uint8_t Phase, uint16_t Value)
+{
+  StSafeA_TraceRing_t *p_ring = &pHwCtx->Trace;
+  uint32_t head = p_ring->Head;
+  StSafeA_TraceEntry_t *p_entry;
+
+  if (Phase == (uint8_t)STSAFEA_TRACE_PHASE_START)
+  {
+    p_ring->Header = (uint8_t)Value;
+  }
+
+  if ((head - p_ring->Tail) >= STSAFEA_TRACE_RING_SIZE)
+  {
+    p_ring->Dropped++;
+    return;
+  }
+
+  p_entry = &p_ring->Entry[head & (STSAFEA_TRACE_RING_SIZE - 1U)];
+  p_entry->Timestamp = (pHwCtx->TimeGetUs != NULL) ? pHwCtx->TimeGetUs() : 0U;
+  p_entry->Header = p_ring->Header;
+  p_entry->Phase = Phase;
+  p_entry->Value = Value;
+
+  /* The entry must be complete before the reader can see it */
+  STSAFEA_TRACE_BARRIER();
+  p_ring->Head = head + 1U;
+}
+
+/**
+  * @brief   StSafeA_TraceRead
+  *          Move the oldest entries out of the trace ring of the device.
+  * @note    Can be called from another thread than the one operating the device, but from a single one at a time.
+  *
+  * @param   pHwCtx    : Hardware context of the device.
+  * @param   pEntries  : Array to be filled with the entries, oldest first.
+  * @param   MaxNumber : Size of the pEntries array.
+  * @retval  Number of entries read.
+  */
+uint16_t StSafeA_TraceRead(STSAFEA_HW_t *pHwCtx, StSafeA_TraceEntry_t *pEntries, uint16_t MaxNumber)
+{
+  StSafeA_TraceRing_t *p_ring = &pHwCtx->Trace;
+  uint32_t tail = p_ring->Tail;
+  uint32_t head = p_ring->Head;
+  uint16_t number = 0;
+
+  /* Do not read the entries before their index */
+  STSAFEA_TRACE_BARRIER();
+
+  while ((tail != head) && (number < MaxNumber))
+  {
+    pEntries[number] = p_ring->Entry[tail & (STSAFEA_TRACE_RING_SIZE - 1U)];
+    tail++;
+    number++;
+  }
+
+  /* The entries must be copied before the writer can reuse them */
+  STSAFEA_TRACE_BARRIER();
+  p_ring->Tail = tail;
+
+  return number;
+}
+#endif /* STSAFEA_USE_TRACE */
 /**
   * @}
   */
@@ -321,53 +548,57 @@ __weak int8_t StSafeA_HW_Probe(void  *pCtx)
   * @brief   StSafeA_SendBytes
   *          Send data to the STSAFE_A1xx device over the configured Bus .
   *
-  * @param   pInBuffer : TLV Structure pointer containing the data to be transmitted
+  * @param   pHwCtx    : Hardware context of the device.
+  * @param   pInBuffer : TLV Structure pointer containing the data to be transmitted.
+  *                      LV.Data must be preceded by STSAFEA_BUFFER_HEADROOM_SIZE bytes of headroom.
   * @retval  0 if success, an error code otherwise
   */
-static int8_t StSafeA_SendBytes(StSafeA_TLVBuffer_t *pInBuffer)
+static int8_t StSafeA_SendBytes(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pInBuffer)
 {
   int8_t status_code = STSAFEA_BUS_ERR;
-  uint16_t loop = 1;
+  int8_t retry_code = STSAFEA_BUS_OK;
+  StSafeA_RetryState_t retry = {0};
 
   uint16_t i2c_length = pInBuffer->LV.Length + STSAFEA_HEADER_LENGTH;
 
   /* In order to avoid excess data sending over I2C */
   /* pInBuffer->LV.Length should not exceed the max allowed size */
-  if (i2c_length > STSAFEA_BUFFER_DATA_PACKET_SIZE)
+  if (i2c_length > pHwCtx->BufferPacketSize)
   {
     return (int8_t)STSAFEA_BUFFER_LENGTH_EXCEEDED;
   }
 
   if (pInBuffer->LV.Data != NULL)
   {
-
     /* To optimize stack size and avoid to allocate memory for a dedicated transmit
-       buffer, the same pInBuffer.Data is used to send over the Bus. The
-       pInBuffer.Data has to be adjusted in the proper way to be used for this scope,
-       in order to include the Header as well. LV.Data must be 1-byte greater than expected.
-       LV.Data is in fact allocated with 4 additional spare bytes (see STSAFEA_BUFFER_DATA_PACKET_SIZE) */
-    (void)memmove((uint8_t *)&pInBuffer->LV.Data[1], (uint8_t *)&pInBuffer->LV.Data[0], pInBuffer->LV.Length);
-    pInBuffer->LV.Data[0] = pInBuffer->Header;
-
+       buffer, the frame is sent straight from pInBuffer.Data: the Header is written
+       in the headroom reserved in front of LV.Data (see STSAFEA_BUFFER_HEADROOM_SIZE),
+       so that the data does not have to be moved */
+    uint8_t *p_frame = pInBuffer->LV.Data - STSAFEA_HEADER_LENGTH;
+    p_frame[0] = pInBuffer->Header;
 
     /* Send to STSAFE-A1xx */
-    while ((status_code != STSAFEA_BUS_OK) && (loop <= (STSAFEA_I2C_POLLING_MAX / STSAFEA_I2C_POLLING_STEP)))
+    StSafeA_RetryStart(pHwCtx, &retry, STSAFEA_I2C_POLLING_STEP);
+    while ((status_code != STSAFEA_BUS_OK) && (retry_code == STSAFEA_BUS_OK))
     {
-      status_code = HwCtx.BusSend(((uint16_t)HwCtx.DevAddr) << 1,
-                                  (uint8_t *)pInBuffer->LV.Data, i2c_length);
+      status_code = pHwCtx->BusSend(pHwCtx->pBusCtx, ((uint16_t)pHwCtx->DevAddr) << 1, p_frame, i2c_length);
 
-      if (status_code == STSAFEA_BUS_NACK)
+      if (status_code != STSAFEA_BUS_OK)
       {
-        HwCtx.TimeDelay(STSAFEA_I2C_POLLING_STEP);
+        retry_code = StSafeA_RetryWait(pHwCtx, &retry);
       }
-
-      loop += STSAFEA_I2C_POLLING_STEP;
     }
 
-    /* Restore initial LV.Data, in case caller expects to re-use it */
-    /* At the moment of this implementation Callers functions never need the transmitted LV.Data
-       so the following restore can be commented for speed optimization */
-    (void)memmove((uint8_t *)&pInBuffer->LV.Data[0], (uint8_t *)&pInBuffer->LV.Data[1], pInBuffer->LV.Length);
+    if ((status_code == STSAFEA_BUS_NACK) && (retry_code == STSAFEA_BUS_TIMEOUT))
+    {
+      status_code = STSAFEA_BUS_TIMEOUT;
+    }
+    else if (status_code == STSAFEA_BUS_OK)
+    {
+      STSAFEA_STATS_ADD(pHwCtx, BytesSent, i2c_length);
+    }
+    STSAFEA_STATS_ADD(pHwCtx, NackRetries, retry.Attempts);
+    STSAFEA_TRACE(pHwCtx, STSAFEA_TRACE_PHASE_BUS_WRITE, retry.Attempts);
   }
   return (status_code);
 }
@@ -376,18 +607,22 @@ static int8_t StSafeA_SendBytes(StSafeA_TLVBuffer_t *pInBuffer)
   * @brief   StSafeA_ReceiveBytes
   *          Receive data from the STSAFE_A1xx device over the configured Bus .
   *
+  * @param   pHwCtx     : Hardware context of the device.
   * @param   pOutBuffer : TLV Structure pointer to be filled with the received data
+  * @param   pCrc       : CRC register accumulated by BusRecvFrame while receiving, NULL if not needed.
   * @retval  0 if success, an error code otherwise
   */
-static int8_t StSafeA_ReceiveBytes(StSafeA_TLVBuffer_t *pOutBuffer)
+static int8_t StSafeA_ReceiveBytes(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pOutBuffer, uint16_t *pCrc)
 {
   uint16_t response_length = pOutBuffer->LV.Length;
   int8_t status_code = STSAFEA_BUS_ERR;
-  uint16_t loop = 1;
+  int8_t retry_code = STSAFEA_BUS_OK;
+  StSafeA_RetryState_t retry = {0};
+  uint8_t *p_frame;
 
   /* In order to avoid excess data sending over I2C */
   /* pInBuffer->LV.Length should not exceed the max allowed size */
-  if ((response_length + STSAFEA_HEADER_LENGTH) > STSAFEA_BUFFER_DATA_PACKET_SIZE)
+  if ((response_length + STSAFEA_HEADER_LENGTH) > pHwCtx->BufferPacketSize)
   {
     return (int8_t)STSAFEA_BUFFER_LENGTH_EXCEEDED;
   }
@@ -395,72 +630,197 @@ static int8_t StSafeA_ReceiveBytes(StSafeA_TLVBuffer_t *pOutBuffer)
   if (pOutBuffer->LV.Data != NULL)
   {
     /* To optimize stack size and avoid to allocate memory for a dedicated receive
-       buffer, the pOutBuffer.Data is used to receive over the Bus. Than the
-       pOutBuffer structure is re-adjusted in the proper way */
-    while ((status_code != STSAFEA_BUS_OK) && (loop <= (STSAFEA_I2C_POLLING_MAX / STSAFEA_I2C_POLLING_STEP)))
+       buffer, the frame is received in pOutBuffer.Data, starting in the headroom reserved
+       in front of LV.Data (see STSAFEA_BUFFER_HEADROOM_SIZE), so that the data directly
+       lands at its final position */
+    p_frame = pOutBuffer->LV.Data - STSAFEA_HEADER_LENGTH - STSAFEA_LENGTH_SIZE;
+    StSafeA_RetryStart(pHwCtx, &retry, STSAFEA_I2C_RECEIVE_POLLING_STEP);
+    while ((status_code != STSAFEA_BUS_OK) && (retry_code == STSAFEA_BUS_OK))
     {
+      if (pHwCtx->BusRecvFrame != NULL)
+      {
+        /* Read the response header, then exactly the announced length, in a single transaction */
+        status_code = pHwCtx->BusRecvFrame(pHwCtx->pBusCtx, ((uint16_t)pHwCtx->DevAddr) << 1,
+                                         p_frame,
+                                         pHwCtx->BufferPacketSize + STSAFEA_LENGTH_SIZE,
+                                         pCrc);
+      }
+      else
+      {
+        status_code = pHwCtx->BusRecv(pHwCtx->pBusCtx, ((uint16_t)pHwCtx->DevAddr) << 1,
+                                    p_frame,
+                                    response_length + STSAFEA_HEADER_LENGTH + STSAFEA_LENGTH_SIZE);
+      }
 
-      status_code = HwCtx.BusRecv(((uint16_t)HwCtx.DevAddr) << 1,
-                                  pOutBuffer->LV.Data,
-                                  response_length + STSAFEA_HEADER_LENGTH + STSAFEA_LENGTH_SIZE);
-
-      if (status_code == STSAFEA_BUS_NACK)
+      if (status_code != STSAFEA_BUS_OK)
       {
-        HwCtx.TimeDelay(STSAFEA_I2C_POLLING_STEP);
+        retry_code = StSafeA_RetryWait(pHwCtx, &retry);
       }
+    }
+    pHwCtx->ResponsePollingTime = retry.Elapsed;
+
+    /* At this point the pOutBuffer.Header, Length are set from the received frame header */
+    pOutBuffer->Header = p_frame[0];
+    pOutBuffer->LV.Length = ((uint16_t)p_frame[1] << 8) + p_frame[2];
 
-      loop += STSAFEA_I2C_POLLING_STEP;
+    if (status_code == STSAFEA_BUS_OK)
+    {
+      STSAFEA_STATS_ADD(pHwCtx, BytesReceived, STSAFEA_HEADER_LENGTH + STSAFEA_LENGTH_SIZE +
+                        ((pHwCtx->BusRecvFrame != NULL) ? pOutBuffer->LV.Length : response_length));
     }
 
-    /* At this point the pOutBuffer.Header, Length, Data is re-adjusted in the proper way*/
-    pOutBuffer->Header = pOutBuffer->LV.Data[0];
-    pOutBuffer->LV.Length = ((uint16_t)pOutBuffer->LV.Data[1] << 8) + pOutBuffer->LV.Data[2];
-    (void)memcpy(pOutBuffer->LV.Data, &pOutBuffer->LV.Data[3], response_length);
+    /* If STSAFE returns a length higher than expected, the response has to fit in the buffer */
+    if ((pOutBuffer->LV.Length > response_length) && (status_code == 0) &&
+        ((pOutBuffer->LV.Length + STSAFEA_HEADER_LENGTH) > pHwCtx->BufferPacketSize))
+    {
+      STSAFEA_STATS_ADD(pHwCtx, NackRetries, retry.Attempts);
+      STSAFEA_TRACE(pHwCtx, STSAFEA_TRACE_PHASE_BUS_READ, retry.Attempts);
+      return (int8_t)STSAFEA_BUFFER_LENGTH_EXCEEDED;
+    }
 
-    /* If STSAFE returns a length higher than expected, a new read with the
-       updated bytes length is executed */
-    if ((pOutBuffer->LV.Length > response_length) && (status_code == 0))
+    /* If STSAFE returns a length higher than expected, and the whole response has not already
+       been read, a new read with the updated bytes length is executed */
+    if ((pOutBuffer->LV.Length > response_length) && (status_code == 0) && (pHwCtx->BusRecvFrame == NULL))
     {
       status_code = STSAFEA_BUS_ERR;
-      loop = 1;
+      STSAFEA_STATS_ADD(pHwCtx, ReReads, 1U);
 
-      while ((status_code != STSAFEA_BUS_OK) && (loop <= (STSAFEA_I2C_POLLING_MAX / STSAFEA_I2C_POLLING_STEP)))
+      StSafeA_RetryStart(pHwCtx, &retry, STSAFEA_I2C_RECEIVE_POLLING_STEP);
+      while ((status_code != STSAFEA_BUS_OK) && (retry_code == STSAFEA_BUS_OK))
       {
-        status_code = HwCtx.BusRecv(((uint16_t)HwCtx.DevAddr) << 1,
-                                    pOutBuffer->LV.Data,
+        status_code = pHwCtx->BusRecv(pHwCtx->pBusCtx, ((uint16_t)pHwCtx->DevAddr) << 1,
+                                    p_frame,
                                     pOutBuffer->LV.Length + STSAFEA_HEADER_LENGTH + STSAFEA_LENGTH_SIZE);
 
-        if (status_code == STSAFEA_BUS_NACK)
+        if (status_code != STSAFEA_BUS_OK)
         {
-          HwCtx.TimeDelay(STSAFEA_I2C_POLLING_STEP);
+          retry_code = StSafeA_RetryWait(pHwCtx, &retry);
         }
-
-        loop += STSAFEA_I2C_POLLING_STEP;
       }
 
-      pOutBuffer->Header = pOutBuffer->LV.Data[0];
-      pOutBuffer->LV.Length = ((uint16_t)pOutBuffer->LV.Data[1] << 8) + pOutBuffer->LV.Data[2];
-      (void)memcpy(pOutBuffer->LV.Data, &pOutBuffer->LV.Data[3], pOutBuffer->LV.Length);
+      pOutBuffer->Header = p_frame[0];
+      pOutBuffer->LV.Length = ((uint16_t)p_frame[1] << 8) + p_frame[2];
+
+      if (status_code == STSAFEA_BUS_OK)
+      {
+        STSAFEA_STATS_ADD(pHwCtx, BytesReceived, pOutBuffer->LV.Length + STSAFEA_HEADER_LENGTH + STSAFEA_LENGTH_SIZE);
+      }
+    }
 
+    if ((status_code == STSAFEA_BUS_NACK) && (retry_code == STSAFEA_BUS_TIMEOUT))
+    {
+      status_code = STSAFEA_BUS_TIMEOUT;
     }
+    STSAFEA_STATS_ADD(pHwCtx, NackRetries, retry.Attempts);
+    STSAFEA_TRACE(pHwCtx, STSAFEA_TRACE_PHASE_BUS_READ, retry.Attempts);
   }
   return (status_code);
 }
 
+/**
+  * @brief   StSafeA_RetryStart
+  *          Start the attempts of a bus phase.
+  *
+  * @param   pHwCtx      : Hardware context of the device.
+  * @param   pRetry      : Attempts state to initialize.
+  * @param   PollingStep : Delay in ms used when the retry policy does not set one.
+  * @retval  None
+  */
+static void StSafeA_RetryStart(STSAFEA_HW_t *pHwCtx, StSafeA_RetryState_t *pRetry, uint32_t PollingStep)
+{
+  pRetry->Delay = (pHwCtx->RetryPolicy.InitialDelay != 0U) ? pHwCtx->RetryPolicy.InitialDelay : PollingStep;
+  pRetry->Elapsed = 0;
+  pRetry->BusyPollStart = (pHwCtx->TimeGetUs != NULL) ? pHwCtx->TimeGetUs() : 0U;
+}
+
+/**
+  * @brief   StSafeA_RetryWait
+  *          Wait before the next attempt of a bus phase which failed, according to the retry policy of the device
+  *          and to the time left to the current command.
+  *
+  * @param   pHwCtx : Hardware context of the device.
+  * @param   pRetry : Attempts state of the bus phase.
+  * @retval  STSAFEA_BUS_OK to attempt again, STSAFEA_BUS_NACK if the bus phase timed out,
+  *          STSAFEA_BUS_TIMEOUT if the deadline of the command is reached.
+  */
+static int8_t StSafeA_RetryWait(STSAFEA_HW_t *pHwCtx, StSafeA_RetryState_t *pRetry)
+{
+  const StSafeA_RetryPolicy_t *p_policy = &pHwCtx->RetryPolicy;
+  uint32_t timeout = (p_policy->Timeout != 0U) ? p_policy->Timeout : STSAFEA_I2C_POLLING_MAX;
+  uint32_t delay = pRetry->Delay;
+
+  pRetry->Attempts++;
+
+  /* Attempt again straight away at the start of the bus phase, for responses which are almost ready */
+  if ((p_policy->BusyPollTime != 0U) && (pHwCtx->TimeGetUs != NULL) &&
+      ((pHwCtx->TimeGetUs() - pRetry->BusyPollStart) < p_policy->BusyPollTime))
+  {
+    return STSAFEA_BUS_OK;
+  }
+
+  if (pRetry->Elapsed >= timeout)
+  {
+    return STSAFEA_BUS_NACK;
+  }
+
+  StSafeA_UpdateTimeLeft(pHwCtx);
+  if (pHwCtx->TimeLeft == 0U)
+  {
+    return STSAFEA_BUS_TIMEOUT;
+  }
+
+  /* Do not wait past the end of the bus phase or the deadline of the command */
+  delay = (delay < (timeout - pRetry->Elapsed)) ? delay : (timeout - pRetry->Elapsed);
+  delay = (delay < pHwCtx->TimeLeft) ? delay : pHwCtx->TimeLeft;
+  StSafeA_Delay(pHwCtx, delay);
+  pRetry->Elapsed += delay;
+
+  if ((p_policy->Backoff == STSAFEA_RETRY_EXPONENTIAL) && (pRetry->Delay < timeout))
+  {
+    pRetry->Delay *= 2U;
+    if ((p_policy->MaxDelay != 0U) && (pRetry->Delay > p_policy->MaxDelay))
+    {
+      pRetry->Delay = p_policy->MaxDelay;
+    }
+  }
+
+  return STSAFEA_BUS_OK;
+}
+
+/**
+  * @brief   StSafeA_UpdateTimeLeft
+  *          Update the time left to the current command from the time elapsed since its start, when the bus layer
+  *          provides TimeGetUs. Otherwise the time left is only decreased by the delays, see StSafeA_Delay.
+  *
+  * @param   pHwCtx : Hardware context of the device.
+  * @retval  None
+  */
+static void StSafeA_UpdateTimeLeft(STSAFEA_HW_t *pHwCtx)
+{
+  uint32_t elapsed;
+
+  if ((pHwCtx->TimeLeft != STSAFEA_NO_DEADLINE) && (pHwCtx->TimeGetUs != NULL))
+  {
+    elapsed = (pHwCtx->TimeGetUs() - pHwCtx->CommandStart) / 1000U;
+    pHwCtx->TimeLeft = (elapsed < pHwCtx->Deadline) ? (pHwCtx->Deadline - elapsed) : 0U;
+  }
+}
+
 /**
   * @brief   StSafeA_Crc16
   *          Computes the CRC16 over the Data passed into the TLV structure.
   *
+  * @param   pHwCtx      : Hardware context of the device.
   * @param   pTLV_Buffer : TLV Structure pointer containing the data to calculate the CRC on.
   * @retval  None
   */
-void StSafeA_Crc16(StSafeA_TLVBuffer_t *pTLV_Buffer)
+void StSafeA_Crc16(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer)
 {
   if ((pTLV_Buffer != NULL))
   {
     uint16_t crc16;
 
-    crc16 = (uint16_t)HwCtx.CrcCompute(&(pTLV_Buffer->Header),
+    crc16 = (uint16_t)pHwCtx->CrcCompute(&(pTLV_Buffer->Header),
                                        1U,
                                        pTLV_Buffer->LV.Data,
                                        pTLV_Buffer->LV.Length);
@@ -470,6 +830,37 @@ void StSafeA_Crc16(StSafeA_TLVBuffer_t *pTLV_Buffer)
   }
 }
 
+/**
+  * @brief   StSafeA_CommandCrc16
+  *          Computes the CRC16 of the command passed into the TLV structure.
+  *          If part of the command has already been accumulated in pHwCtx->TxCrc while it was copied into the
+  *          buffer, only the remaining bytes (e.g. the C-MAC) are processed.
+  *
+  * @param   pHwCtx      : Hardware context of the device.
+  * @param   pTLV_Buffer : TLV Structure pointer containing the command to calculate the CRC on.
+  * @retval  None
+  */
+static void StSafeA_CommandCrc16(STSAFEA_HW_t *pHwCtx, StSafeA_TLVBuffer_t *pTLV_Buffer)
+{
+  if ((pHwCtx->CrcUpdate != NULL) && (pHwCtx->TxCrcLength != STSAFEA_CRC_NOT_ACCUMULATED) &&
+      (pHwCtx->TxCrcLength <= pTLV_Buffer->LV.Length) && (pHwCtx->TxCrcHeader == pTLV_Buffer->Header))
+  {
+    uint16_t crc16 = pHwCtx->CrcUpdate(pHwCtx->TxCrc, NULL, &pTLV_Buffer->LV.Data[pHwCtx->TxCrcLength],
+                                       pTLV_Buffer->LV.Length - pHwCtx->TxCrcLength);
+
+    crc16 = (uint16_t)(SWAP2BYTES(crc16) ^ 0xFFFFU);
+    (void)memcpy(&pTLV_Buffer->LV.Data[pTLV_Buffer->LV.Length], &crc16, sizeof(crc16));
+    pTLV_Buffer->LV.Length += STSAFEA_CRC_LENGTH;
+  }
+  else
+  {
+    StSafeA_Crc16(pHwCtx, pTLV_Buffer);
+  }
+
+  /* The accumulation only holds for this command */
+  pHwCtx->TxCrcLength = STSAFEA_CRC_NOT_ACCUMULATED;
+}
+
 /**
   * @}
   */
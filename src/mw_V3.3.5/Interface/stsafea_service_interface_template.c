@@ -34,20 +34,57 @@
 /* Private define ------------------------------------------------------------*/
 #define STSAFEA_DEVICE_ADDRESS                    0x0020
 
-#define I2C_Init                                  BSP_I2C1_Init
-#define I2C_DeInit                                BSP_I2C1_DeInit
-
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
-int32_t I2C_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
-int32_t I2C_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
+int32_t IO_Init(void *pBusCtx);
+int32_t I2C_Init(void *pBusCtx);
+int32_t I2C_DeInit(void *pBusCtx);
+int32_t I2C_Send(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length);
+int32_t I2C_Recv(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length);
 
 /* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  IO_Init
+  *         Initialize the STSAFE IOs. Single bus platform: the bus context is unused.
+  * @param  pBusCtx : Bus context.
+  * @retval 0 in case of success, an error code otherwise
+  */
+int32_t IO_Init(void *pBusCtx)
+{
+  (void)pBusCtx;
+  return HW_IO_Init();
+}
+
+/**
+  * @brief  I2C_Init
+  *         Initialize the BUS. Single bus platform: the bus context is unused.
+  * @param  pBusCtx : Bus context.
+  * @retval BSP status
+  */
+int32_t I2C_Init(void *pBusCtx)
+{
+  (void)pBusCtx;
+  return BSP_I2C1_Init();
+}
+
+/**
+  * @brief  I2C_DeInit
+  *         De-initialize the BUS. Single bus platform: the bus context is unused.
+  * @param  pBusCtx : Bus context.
+  * @retval BSP status
+  */
+int32_t I2C_DeInit(void *pBusCtx)
+{
+  (void)pBusCtx;
+  return BSP_I2C1_DeInit();
+}
+
 /**
   * @brief  I2C_Send
   *         send data through BUS.
+  * @param  pBusCtx : Bus context.
   * @param  DevAddr : Device address on Bus.
   * @param  pData   : Pointer to data buffer to write
   * @param  Length  : Data Length
@@ -55,10 +92,11 @@ int32_t I2C_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
   * @retval STSAFEA_HW_NACK : on bus NACK
   * @retval STSAFEA_HW_ERR  : on bus error
   */
-int32_t I2C_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
+int32_t I2C_Send(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 {
   int32_t ret;
 
+  (void)pBusCtx;
   ret = BSP_I2C1_Send(DevAddr, pData, Length);
   if (ret == BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE)
   {
@@ -76,16 +114,18 @@ int32_t I2C_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 /**
   * @brief  I2C_Recv
   *         Receive data through BUS.
+  * @param  pBusCtx Bus context.
   * @param  DevAddr Device address on Bus.
   * @param  Reg    The target register address to read
   * @param  pData  Pointer to data buffer to read
   * @param  Length Data Length
   * @retval BSP status
   */
-int32_t I2C_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
+int32_t I2C_Recv(void *pBusCtx, uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 {
   int32_t ret;
 
+  (void)pBusCtx;
   ret = BSP_I2C1_Recv(DevAddr, pData, Length);
   if (ret == BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE)
   {
@@ -102,7 +142,9 @@ int32_t I2C_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length)
 
 /**
   * @brief  StSafeA_HW_Probe
-  *         Configure STSAFE IO and Bus operation functions to be implemented at User level
+  *         Configure STSAFE IO and Bus operation functions to be implemented at User level.
+  *         DevAddr and pBusCtx may be preset by StSafeA_InitDevice: a non-zero DevAddr
+  *         is kept and pBusCtx is forwarded untouched to the bus functions.
   * @param  Ctx the STSAFE IO context
   * @retval 0 in case of success, an error code otherwise
   */
@@ -111,15 +153,23 @@ int8_t StSafeA_HW_Probe(void *pCtx)
   STSAFEA_HW_t *HwCtx = (STSAFEA_HW_t *)pCtx;
 
 
-  HwCtx->IOInit     = HW_IO_Init;
+  HwCtx->IOInit     = IO_Init;
   HwCtx->BusInit    = I2C_Init;
   HwCtx->BusDeInit  = I2C_DeInit;
   HwCtx->BusSend    = I2C_Send;
   HwCtx->BusRecv    = I2C_Recv;
+  HwCtx->BusRecvFrame = NULL;
   HwCtx->CrcInit    = CRC16X25_Init;
   HwCtx->CrcCompute = CRC_Compute;
+  HwCtx->CrcUpdate  = NULL;
   HwCtx->TimeDelay  = HAL_Delay;
-  HwCtx->DevAddr    = STSAFEA_DEVICE_ADDRESS;
+  HwCtx->BusDelay   = NULL;
+  HwCtx->TimeGetUs  = NULL;
+  HwCtx->CycleCount = NULL;
+  if (HwCtx->DevAddr == 0U)
+  {
+    HwCtx->DevAddr  = STSAFEA_DEVICE_ADDRESS;
+  }
 
   return STSAFEA_BUS_OK;
 }
@@ -4,38 +4,42 @@
  */
 #include "stsafe_a110/stsafe_a110.h"
 #include "stsafea_core.h"
+#include "stsafea_trace.h"
 
 namespace sixtron {
 
-static StSafeA_Handle_t stsafe_handler;
-static uint8_t rx_tx_buffer[STSAFEA_BUFFER_MAX_SIZE];
-
-STSafeA110::STSafeA110()
+STSafeA110Base::STSafeA110Base(
+        uint8_t *buffer, uint16_t buffer_size, STSafeA110Bus *bus, uint16_t address):
+        _bus(bus), _address(address), _buffer(buffer), _buffer_size(buffer_size), _capturing(false)
 {
 }
 
-int STSafeA110::init()
+int STSafeA110Base::init()
 {
-    return StSafeA_Init(&stsafe_handler, rx_tx_buffer) != STSAFEA_OK;
+    if (StSafeA_InitDevice(&_handle, _buffer, _bus, _address) != STSAFEA_OK) {
+        return 1;
+    }
+
+    return StSafeA_SetBufferSize(&_handle, _buffer_size) != STSAFEA_OK;
 }
 
-int STSafeA110::echo(uint8_t *buffer_in, uint8_t *buffer_out, size_t length)
+int STSafeA110Base::echo(uint8_t *buffer_in, uint8_t *buffer_out, size_t length)
 {
     StSafeA_LVBuffer_t lv_buffer;
     lv_buffer.Data = buffer_out;
     lv_buffer.Length = length;
 
-    return StSafeA_Echo(&stsafe_handler, buffer_in, length, &lv_buffer, STSAFEA_MAC_NONE)
+    return StSafeA_Echo(&_handle, buffer_in, length, &lv_buffer, STSAFEA_MAC_NONE)
             != STSAFEA_OK;
 }
 
-int STSafeA110::update_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length)
+int STSafeA110Base::update_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length)
 {
     StSafeA_LVBuffer_t lv_buffer;
     lv_buffer.Data = buf;
     lv_buffer.Length = length;
 
-    return StSafeA_Update(&stsafe_handler,
+    return StSafeA_Update(&_handle,
                    STSAFEA_FLAG_FALSE,
                    STSAFEA_FLAG_FALSE,
                    STSAFEA_FLAG_FALSE,
@@ -47,13 +51,13 @@ int STSafeA110::update_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t
             != STSAFEA_OK;
 }
 
-int STSafeA110::read_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length)
+int STSafeA110Base::read_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length)
 {
     StSafeA_LVBuffer_t lv_buffer;
     lv_buffer.Data = buf;
     lv_buffer.Length = length;
 
-    return StSafeA_Read(&stsafe_handler,
+    return StSafeA_Read(&_handle,
                    STSAFEA_FLAG_FALSE,
                    STSAFEA_FLAG_FALSE,
                    STSAFEA_AC_ALWAYS,
@@ -66,4 +70,553 @@ int STSafeA110::read_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t l
             != STSAFEA_OK;
 }
 
+int STSafeA110Base::generate_random(uint8_t *buf, uint8_t length)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    lv_buffer.Data = buf;
+    lv_buffer.Length = length;
+
+    return StSafeA_GenerateRandom(&_handle, STSAFEA_EPHEMERAL_RND, length, &lv_buffer, STSAFEA_MAC_NONE)
+            != STSAFEA_OK;
+}
+
+int STSafeA110Base::read_data_partition(
+        uint8_t zone_index, uint16_t offset, uint16_t length, STSafeA110View *view)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    StSafeA_ResponseCode_t code;
+    lv_buffer.Data = nullptr;
+    lv_buffer.Length = length;
+
+    *view = STSafeA110View();
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_TRUE);
+    code = StSafeA_Read(&_handle,
+            STSAFEA_FLAG_FALSE,
+            STSAFEA_FLAG_FALSE,
+            STSAFEA_AC_ALWAYS,
+            zone_index,
+            offset,
+            length,
+            length,
+            &lv_buffer,
+            STSAFEA_MAC_NONE);
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_FALSE);
+    if ((code != STSAFEA_OK) || (lv_buffer.Data == nullptr)) {
+        return 1;
+    }
+    *view = STSafeA110View(&_handle, lv_buffer.Data, lv_buffer.Length);
+
+    return 0;
+}
+
+int STSafeA110Base::generate_random(uint8_t length, STSafeA110View *view)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    StSafeA_ResponseCode_t code;
+    lv_buffer.Data = nullptr;
+    lv_buffer.Length = length;
+
+    *view = STSafeA110View();
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_TRUE);
+    code = StSafeA_GenerateRandom(
+            &_handle, STSAFEA_EPHEMERAL_RND, length, &lv_buffer, STSAFEA_MAC_NONE);
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_FALSE);
+    if ((code != STSAFEA_OK) || (lv_buffer.Data == nullptr)) {
+        return 1;
+    }
+    *view = STSafeA110View(&_handle, lv_buffer.Data, lv_buffer.Length);
+
+    return 0;
+}
+
+int STSafeA110Base::generate_signature(uint8_t key_slot,
+        const uint8_t *digest,
+        StSafeA_HashTypes_t digest_type,
+        STSafeA110View *r,
+        STSafeA110View *s)
+{
+    uint16_t length = (digest_type == STSAFEA_SHA_384) ? STSAFEA_XYRS_ECDSA_SHA384_LENGTH
+                                                       : STSAFEA_XYRS_ECDSA_SHA256_LENGTH;
+    StSafeA_LVBuffer_t sign_r;
+    StSafeA_LVBuffer_t sign_s;
+    StSafeA_ResponseCode_t code;
+    sign_r.Data = nullptr;
+    sign_r.Length = length;
+    sign_s.Data = nullptr;
+    sign_s.Length = length;
+
+    *r = STSafeA110View();
+    *s = STSafeA110View();
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_TRUE);
+    code = StSafeA_GenerateSignature(&_handle,
+            key_slot,
+            digest,
+            digest_type,
+            length,
+            &sign_r,
+            &sign_s,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+    StSafeA_SetInPlaceResponse(&_handle, STSAFEA_FLAG_FALSE);
+    if ((code != STSAFEA_OK) || (sign_r.Data == nullptr) || (sign_s.Data == nullptr)) {
+        return 1;
+    }
+    *r = STSafeA110View(&_handle, sign_r.Data, sign_r.Length);
+    *s = STSafeA110View(&_handle, sign_s.Data, sign_s.Length);
+
+    return 0;
+}
+
+int STSafeA110Base::generate_signature(
+        uint8_t key_slot, const uint8_t *digest, StSafeA_HashTypes_t digest_type, uint8_t *r, uint8_t *s)
+{
+    uint16_t length = (digest_type == STSAFEA_SHA_384) ? STSAFEA_XYRS_ECDSA_SHA384_LENGTH
+                                                       : STSAFEA_XYRS_ECDSA_SHA256_LENGTH;
+    StSafeA_LVBuffer_t sign_r;
+    StSafeA_LVBuffer_t sign_s;
+    sign_r.Data = r;
+    sign_r.Length = length;
+    sign_s.Data = s;
+    sign_s.Length = length;
+
+    return StSafeA_GenerateSignature(&_handle,
+                   key_slot,
+                   digest,
+                   digest_type,
+                   length,
+                   &sign_r,
+                   &sign_s,
+                   STSAFEA_MAC_NONE,
+                   STSAFEA_ENCRYPTION_NONE)
+            != STSAFEA_OK;
+}
+
+int STSafeA110Base::establish_key(uint8_t key_slot,
+        const uint8_t *public_x,
+        const uint8_t *public_y,
+        uint16_t length,
+        uint8_t *shared_secret)
+{
+    StSafeA_LVBuffer_t pub_x;
+    StSafeA_LVBuffer_t pub_y;
+    StSafeA_SharedSecretBuffer_t secret;
+    pub_x.Data = (uint8_t *)public_x;
+    pub_x.Length = length;
+    pub_y.Data = (uint8_t *)public_y;
+    pub_y.Length = length;
+    secret.SharedKey.Data = shared_secret;
+    secret.SharedKey.Length = length;
+
+    return StSafeA_EstablishKey(&_handle,
+                   key_slot,
+                   &pub_x,
+                   &pub_y,
+                   length,
+                   &secret,
+                   STSAFEA_MAC_NONE,
+                   STSAFEA_ENCRYPTION_NONE)
+            != STSAFEA_OK;
+}
+
+/* Coordinate, signature half, digest and shared secret size of the curve */
+static uint16_t curve_length(StSafeA_CurveId_t curve)
+{
+    return ((curve == STSAFEA_NIST_P_384) || (curve == STSAFEA_BRAINPOOL_P_384))
+            ? STSAFEA_XYRS_ECDSA_SHA384_LENGTH
+            : STSAFEA_XYRS_ECDSA_SHA256_LENGTH;
+}
+
+static bool is_ecc_length(size_t length)
+{
+    return (length == STSAFEA_XYRS_ECDSA_SHA256_LENGTH)
+            || (length == STSAFEA_XYRS_ECDSA_SHA384_LENGTH);
+}
+
+static StSafeA_LVBuffer_t lv_buffer_of(STSafeA110Span<const uint8_t> span)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    lv_buffer.Data = const_cast<uint8_t *>(span.data());
+    lv_buffer.Length = span.size();
+
+    return lv_buffer;
+}
+
+STSafeA110Result STSafeA110Base::generate_random(STSafeA110Span<uint8_t> buffer)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    StSafeA_ResponseCode_t code;
+
+    if ((buffer.data() == nullptr) || (buffer.size() == 0) || (buffer.size() > UINT8_MAX)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    lv_buffer.Data = buffer.data();
+    lv_buffer.Length = buffer.size();
+
+    code = StSafeA_GenerateRandom(
+            &_handle, STSAFEA_EPHEMERAL_RND, buffer.size(), &lv_buffer, STSAFEA_MAC_NONE);
+
+    return STSafeA110Result(code, lv_buffer.Length);
+}
+
+STSafeA110Result STSafeA110Base::generate_key_pair(uint8_t key_slot,
+        StSafeA_CurveId_t curve,
+        STSafeA110Span<uint8_t> public_x,
+        STSafeA110Span<uint8_t> public_y,
+        uint8_t authorization_flags,
+        uint16_t use_limit)
+{
+    uint16_t length = curve_length(curve);
+    uint8_t point_representation;
+    StSafeA_LVBuffer_t pub_x;
+    StSafeA_LVBuffer_t pub_y;
+    StSafeA_ResponseCode_t code;
+
+    if ((public_x.data() == nullptr) || (public_x.size() < length) || (public_y.data() == nullptr)
+            || (public_y.size() < length)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    pub_x.Data = public_x.data();
+    pub_x.Length = length;
+    pub_y.Data = public_y.data();
+    pub_y.Length = length;
+
+    code = StSafeA_GenerateKeyPair(&_handle,
+            key_slot,
+            use_limit,
+            STSAFEA_FLAG_FALSE,
+            authorization_flags,
+            curve,
+            length,
+            &point_representation,
+            &pub_x,
+            &pub_y,
+            STSAFEA_MAC_NONE);
+
+    return STSafeA110Result(code, pub_x.Length);
+}
+
+STSafeA110Result STSafeA110Base::generate_signature(uint8_t key_slot,
+        STSafeA110Span<const uint8_t> digest,
+        STSafeA110Span<uint8_t> r,
+        STSafeA110Span<uint8_t> s)
+{
+    uint16_t length = digest.size();
+    StSafeA_LVBuffer_t sign_r;
+    StSafeA_LVBuffer_t sign_s;
+    StSafeA_ResponseCode_t code;
+
+    if ((digest.data() == nullptr) || !is_ecc_length(length) || (r.data() == nullptr)
+            || (r.size() < length) || (s.data() == nullptr) || (s.size() < length)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    sign_r.Data = r.data();
+    sign_r.Length = length;
+    sign_s.Data = s.data();
+    sign_s.Length = length;
+
+    code = StSafeA_GenerateSignature(&_handle,
+            key_slot,
+            digest.data(),
+            (length == STSAFEA_SHA_384_LENGTH) ? STSAFEA_SHA_384 : STSAFEA_SHA_256,
+            length,
+            &sign_r,
+            &sign_s,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+
+    return STSafeA110Result(code, sign_r.Length);
+}
+
+STSafeA110Result STSafeA110Base::verify_message_signature(StSafeA_CurveId_t curve,
+        STSafeA110Span<const uint8_t> public_x,
+        STSafeA110Span<const uint8_t> public_y,
+        STSafeA110Span<const uint8_t> r,
+        STSafeA110Span<const uint8_t> s,
+        STSafeA110Span<const uint8_t> digest,
+        bool *valid)
+{
+    uint16_t length = curve_length(curve);
+    StSafeA_LVBuffer_t pub_x = lv_buffer_of(public_x);
+    StSafeA_LVBuffer_t pub_y = lv_buffer_of(public_y);
+    StSafeA_LVBuffer_t sign_r = lv_buffer_of(r);
+    StSafeA_LVBuffer_t sign_s = lv_buffer_of(s);
+    StSafeA_LVBuffer_t hash = lv_buffer_of(digest);
+    StSafeA_VerifySignatureBuffer_t verification;
+    StSafeA_ResponseCode_t code;
+
+    if ((valid == nullptr) || (public_x.size() != length) || (public_y.size() != length)
+            || (r.size() != length) || (s.size() != length) || !is_ecc_length(digest.size())) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+
+    code = StSafeA_VerifyMessageSignature(&_handle,
+            curve,
+            &pub_x,
+            &pub_y,
+            &sign_r,
+            &sign_s,
+            &hash,
+            &verification,
+            STSAFEA_MAC_NONE);
+    *valid = (code == STSAFEA_OK) && (verification.SignatureValidity != 0);
+
+    return STSafeA110Result(code);
+}
+
+STSafeA110Result STSafeA110Base::establish_key(uint8_t key_slot,
+        STSafeA110Span<const uint8_t> public_x,
+        STSafeA110Span<const uint8_t> public_y,
+        STSafeA110Span<uint8_t> shared_secret)
+{
+    uint16_t length = public_x.size();
+    StSafeA_LVBuffer_t pub_x = lv_buffer_of(public_x);
+    StSafeA_LVBuffer_t pub_y = lv_buffer_of(public_y);
+    StSafeA_SharedSecretBuffer_t secret;
+    StSafeA_ResponseCode_t code;
+
+    if ((public_x.data() == nullptr) || (public_y.data() == nullptr) || !is_ecc_length(length)
+            || (public_y.size() != length) || (shared_secret.data() == nullptr)
+            || (shared_secret.size() < length)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    secret.SharedKey.Data = shared_secret.data();
+    secret.SharedKey.Length = length;
+
+    code = StSafeA_EstablishKey(&_handle,
+            key_slot,
+            &pub_x,
+            &pub_y,
+            length,
+            &secret,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+
+    return STSafeA110Result(code, secret.SharedKey.Length);
+}
+
+STSafeA110Result STSafeA110Base::generate_local_envelope_key(uint8_t key_slot, uint8_t key_type)
+{
+    return STSafeA110Result(StSafeA_GenerateLocalEnvelopeKey(
+            &_handle, key_slot, key_type, nullptr, 0, STSAFEA_MAC_NONE));
+}
+
+STSafeA110Result STSafeA110Base::wrap_local_envelope(
+        uint8_t key_slot, STSafeA110Span<const uint8_t> data, STSafeA110Span<uint8_t> envelope)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    StSafeA_ResponseCode_t code;
+
+    if ((data.data() == nullptr) || (data.size() == 0) || (data.size() % 8 != 0)
+            || (envelope.data() == nullptr) || (envelope.size() < data.size() + 8)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    lv_buffer.Data = envelope.data();
+    lv_buffer.Length = data.size() + 8;
+
+    code = StSafeA_WrapLocalEnvelope(&_handle,
+            key_slot,
+            const_cast<uint8_t *>(data.data()),
+            data.size(),
+            &lv_buffer,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+
+    return STSafeA110Result(code, lv_buffer.Length);
+}
+
+STSafeA110Result STSafeA110Base::unwrap_local_envelope(
+        uint8_t key_slot, STSafeA110Span<const uint8_t> envelope, STSafeA110Span<uint8_t> data)
+{
+    StSafeA_LVBuffer_t lv_buffer;
+    StSafeA_ResponseCode_t code;
+
+    if ((envelope.data() == nullptr) || (envelope.size() <= 8) || (envelope.size() % 8 != 0)
+            || (data.data() == nullptr) || (data.size() < envelope.size() - 8)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    lv_buffer.Data = data.data();
+    lv_buffer.Length = envelope.size() - 8;
+
+    code = StSafeA_UnwrapLocalEnvelope(&_handle,
+            key_slot,
+            const_cast<uint8_t *>(envelope.data()),
+            envelope.size(),
+            &lv_buffer,
+            STSAFEA_MAC_NONE,
+            STSAFEA_ENCRYPTION_NONE);
+
+    return STSafeA110Result(code, lv_buffer.Length);
+}
+
+STSafeA110Result STSafeA110Base::decrement(uint8_t zone_index,
+        uint32_t amount,
+        uint32_t *counter,
+        STSafeA110Span<const uint8_t> data,
+        uint16_t offset)
+{
+    StSafeA_LVBuffer_t lv_buffer = lv_buffer_of(data);
+    StSafeA_DecrementBuffer_t decrement;
+    StSafeA_ResponseCode_t code;
+
+    if (counter == nullptr) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+
+    code = StSafeA_Decrement(&_handle,
+            STSAFEA_FLAG_FALSE,
+            STSAFEA_FLAG_FALSE,
+            STSAFEA_AC_ALWAYS,
+            zone_index,
+            offset,
+            amount,
+            &lv_buffer,
+            &decrement,
+            STSAFEA_MAC_NONE);
+    if (code == STSAFEA_OK) {
+        *counter = decrement.OneWayCounter;
+    }
+
+    return STSafeA110Result(code);
+}
+
+STSafeA110Result STSafeA110Base::query_product_data(StSafeA_ProductDataBuffer_t *product_data)
+{
+    return STSafeA110Result(StSafeA_ProductDataQuery(&_handle, product_data, STSAFEA_MAC_NONE));
+}
+
+STSafeA110Result STSafeA110Base::query_data_partition(
+        STSafeA110Span<StSafeA_ZoneInformationRecordBuffer_t> zones)
+{
+    StSafeA_DataPartitionBuffer_t partition;
+    StSafeA_ResponseCode_t code;
+
+    if ((zones.data() == nullptr) || (zones.size() == 0)) {
+        return STSafeA110Result(STSAFEA_INVALID_PARAMETER);
+    }
+    partition.pZoneInfoRecord = zones.data();
+
+    code = StSafeA_DataPartitionQuery(&_handle,
+            (zones.size() < UINT8_MAX) ? zones.size() : UINT8_MAX,
+            &partition,
+            STSAFEA_MAC_NONE);
+
+    return STSafeA110Result(code, (code == STSAFEA_OK) ? partition.NumberOfZones : 0);
+}
+
+STSafeA110Result STSafeA110Base::query_i2c_parameters(StSafeA_I2cParameterBuffer_t *parameters)
+{
+    return STSafeA110Result(StSafeA_I2cParameterQuery(&_handle, parameters, STSAFEA_MAC_NONE));
+}
+
+STSafeA110Result STSafeA110Base::query_life_cycle_state(StSafeA_LifeCycleStateBuffer_t *state)
+{
+    return STSafeA110Result(StSafeA_LifeCycleStateQuery(&_handle, state, STSAFEA_MAC_NONE));
+}
+
+STSafeA110Result STSafeA110Base::query_host_key_slot(StSafeA_HostKeySlotBuffer_t *slot)
+{
+    return STSafeA110Result(StSafeA_HostKeySlotQuery(&_handle, slot, STSAFEA_MAC_NONE));
+}
+
+STSafeA110Result STSafeA110Base::query_local_envelope_key_slots(
+        StSafeA_LocalEnvelopeKeyTableBuffer_t *table,
+        StSafeA_LocalEnvelopeKeyInformationRecordBuffer_t *slot_0,
+        StSafeA_LocalEnvelopeKeyInformationRecordBuffer_t *slot_1)
+{
+    return STSafeA110Result(StSafeA_LocalEnvelopeKeySlotQuery(
+            &_handle, table, slot_0, slot_1, STSAFEA_MAC_NONE));
+}
+
+int STSafeA110Base::hibernate()
+{
+    return StSafeA_Hibernate(&_handle, STSAFEA_WAKEUP_FROM_I2C_START_OR_RESET, STSAFEA_MAC_NONE)
+            != STSAFEA_OK;
+}
+
+/* The device NACKs the I2C start waking it up, the echo is polled until it has restarted */
+int STSafeA110Base::wake()
+{
+    uint8_t data = 0;
+    uint8_t echo = 0;
+
+    return this->echo(&data, &echo, 1);
+}
+
+int STSafeA110Base::set_retry_policy(const StSafeA_RetryPolicy_t *policy)
+{
+    return StSafeA_SetRetryPolicy(&_handle, policy) != STSAFEA_OK;
+}
+
+int STSafeA110Base::set_deadline(uint32_t deadline_ms)
+{
+    return StSafeA_SetDeadline(&_handle, deadline_ms) != STSAFEA_OK;
+}
+
+#if STSAFEA_USE_STATISTICS
+int STSafeA110Base::stats(StSafeA_Statistics_t *snapshot)
+{
+    return StSafeA_GetStatistics(&_handle, snapshot) != STSAFEA_OK;
+}
+
+int STSafeA110Base::reset_stats()
+{
+    return StSafeA_ResetStatistics(&_handle) != STSAFEA_OK;
+}
+#endif
+
+#if STSAFEA_USE_PROFILING
+int STSafeA110Base::get_profile(StSafeA_Profile_t *profile)
+{
+    return StSafeA_GetProfile(&_handle, profile) != STSAFEA_OK;
+}
+
+int STSafeA110Base::reset_profile()
+{
+    return StSafeA_ResetProfile(&_handle) != STSAFEA_OK;
+}
+#endif
+
+#if STSAFEA_USE_TRACE
+int STSafeA110Base::dump_trace(FILE *stream)
+{
+    return stsafea_trace_dump(&_handle, stream) < 0;
+}
+#endif
+
+int STSafeA110Base::start_capture(uint8_t *buffer, uint32_t size)
+{
+    if (_capturing || (buffer == nullptr)) {
+        return 1;
+    }
+
+    stsafea_capture_start(&_capture, &_handle, buffer, size);
+    _capturing = true;
+
+    return 0;
+}
+
+int32_t STSafeA110Base::stop_capture()
+{
+    if (!_capturing) {
+        return -1;
+    }
+
+    stsafea_capture_stop(&_capture, &_handle);
+    _capturing = false;
+
+    return (_capture.dropped == 0) ? (int32_t)_capture.length : -1;
+}
+
+#if STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME
+int STSafeA110Base::get_latency_model(StSafeA_LatencyModel_t *model)
+{
+    return StSafeA_GetLatencyModel(&_handle, model) != STSAFEA_OK;
+}
+
+int STSafeA110Base::set_latency_model(const StSafeA_LatencyModel_t *model)
+{
+    return StSafeA_SetLatencyModel(&_handle, model) != STSAFEA_OK;
+}
+#endif
+
 } // namespace sixtron
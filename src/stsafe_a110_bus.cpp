@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafe_a110/stsafe_a110_bus.h"
+#include "hal/us_ticker_api.h"
+
+namespace sixtron {
+
+static I2C default_i2c(MBED_CONF_STM_STSAFE_A110_I2C_SDA, MBED_CONF_STM_STSAFE_A110_I2C_SCL);
+static STSafeA110Bus default_bus(&default_i2c);
+
+STSafeA110Bus::STSafeA110Bus(I2C *i2c):
+        _i2c(i2c),
+        _depth(0),
+        _repeated(false),
+        _acquire_time(0),
+        _occupancy {},
+        _reset_time(Kernel::Clock::now())
+{
+}
+
+STSafeA110Bus *STSafeA110Bus::get_default()
+{
+    return &default_bus;
+}
+
+I2C *STSafeA110Bus::i2c()
+{
+    return _i2c;
+}
+
+void STSafeA110Bus::acquire()
+{
+    uint32_t start = us_ticker_read();
+
+    _mutex.lock();
+
+    /* Nested acquisitions of the owner are part of the outer one */
+    if (_depth++ != 0) {
+        return;
+    }
+
+    uint32_t now = us_ticker_read();
+    uint32_t wait_us = now - start;
+
+    _occupancy.transactions++;
+    _occupancy.wait_us += wait_us;
+    if (wait_us > _occupancy.max_wait_us) {
+        _occupancy.max_wait_us = wait_us;
+    }
+    _acquire_time = now;
+}
+
+void STSafeA110Bus::release()
+{
+    if (--_depth == 0) {
+        _occupancy.busy_us += us_ticker_read() - _acquire_time;
+    }
+
+    _mutex.unlock();
+}
+
+int STSafeA110Bus::write(int address, const char *data, int length, bool repeated)
+{
+    int ret;
+
+    acquire();
+    ret = _i2c->write(address, data, length, repeated);
+    end_transfer(repeated && (ret == 0));
+
+    return ret;
+}
+
+int STSafeA110Bus::read(int address, char *data, int length, bool repeated)
+{
+    int ret;
+
+    acquire();
+    ret = _i2c->read(address, data, length, repeated);
+    end_transfer(repeated && (ret == 0));
+
+    return ret;
+}
+
+/* A transfer ending without STOP keeps its acquisition until the transfer ending the transaction */
+void STSafeA110Bus::end_transfer(bool repeated)
+{
+    if (repeated && !_repeated) {
+        _repeated = true;
+        return;
+    }
+
+    release();
+    if (!repeated && _repeated) {
+        _repeated = false;
+        release();
+    }
+}
+
+int STSafeA110Bus::get_occupancy(Occupancy *occupancy)
+{
+    if (occupancy == nullptr) {
+        return -1;
+    }
+
+    _mutex.lock();
+    *occupancy = _occupancy;
+    occupancy->elapsed_ms = (Kernel::Clock::now() - _reset_time).count();
+    _mutex.unlock();
+
+    return 0;
+}
+
+void STSafeA110Bus::reset_occupancy()
+{
+    _mutex.lock();
+    _occupancy = {};
+    _reset_time = Kernel::Clock::now();
+    _mutex.unlock();
+}
+
+} // namespace sixtron
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafe_a110/stsafe_a110_dispatcher.h"
+
+namespace sixtron {
+
+STSafeA110Dispatcher::STSafeA110Dispatcher(osPriority thread_priority, uint32_t stack_size):
+        _thread(thread_priority, stack_size, nullptr, "stsafe"),
+        _device(nullptr),
+        _idle_ms(0),
+        _hibernated(false),
+        _stats {},
+        _state_time(Kernel::Clock::now())
+{
+}
+
+int STSafeA110Dispatcher::start()
+{
+    return _thread.start(callback(this, &STSafeA110Dispatcher::run)) != osOK;
+}
+
+void STSafeA110Dispatcher::enable_auto_hibernate(STSafeA110Base *device, uint32_t idle_ms)
+{
+    _device = (idle_ms != 0) ? device : nullptr;
+    _idle_ms = idle_ms;
+}
+
+int STSafeA110Dispatcher::get_power_stats(PowerStats *stats)
+{
+    if (stats == nullptr) {
+        return -1;
+    }
+
+    _mutex.lock();
+    *stats = _stats;
+    /* Account for the current state up to now */
+    uint32_t current_ms = (Kernel::Clock::now() - _state_time).count();
+    if (_hibernated) {
+        stats->hibernated_ms += current_ms;
+    } else {
+        stats->awake_ms += current_ms;
+    }
+    _mutex.unlock();
+
+    return 0;
+}
+
+void STSafeA110Dispatcher::reset_power_stats()
+{
+    _mutex.lock();
+    _stats = {};
+    _state_time = Kernel::Clock::now();
+    _mutex.unlock();
+}
+
+/* Queue a command without waiting for it. Returns non-zero if the queue is full. */
+int STSafeA110Dispatcher::post(Command command, Completion completion, Priority priority)
+{
+    return queue(command, completion, nullptr, nullptr, priority);
+}
+
+/* Queue a command and wait for its result. Returns non-zero if the queue is full. */
+int STSafeA110Dispatcher::call(Command command, Priority priority)
+{
+    Semaphore done(0, 1);
+    int result;
+
+    /* Called from a command or a completion: the worker thread would wait for itself, so the
+     * command runs inline, the device being already awake */
+    if (is_worker_thread()) {
+        result = command();
+
+        _mutex.lock();
+        _stats.commands++;
+        _mutex.unlock();
+
+        return result;
+    }
+
+    if (queue(command, nullptr, &done, &result, priority) != 0) {
+        return -1;
+    }
+
+    done.acquire();
+
+    return result;
+}
+
+bool STSafeA110Dispatcher::is_worker_thread() const
+{
+    return ThisThread::get_id() == _thread.get_id();
+}
+
+int STSafeA110Dispatcher::queue(
+        Command command, Completion completion, Semaphore *done, int *result, Priority priority)
+{
+    Request *request = _pool.try_alloc();
+
+    if (request == nullptr) {
+        return -1;
+    }
+
+    new (request) Request { command, completion, done, result };
+
+    /* The queue holds as many requests as the pool, so it cannot be full here */
+    _queue.try_put(request, priority);
+
+    return 0;
+}
+
+void STSafeA110Dispatcher::run()
+{
+    Request *request;
+
+    while (true) {
+        Kernel::Clock::duration_u32 timeout = Kernel::wait_for_u32_forever;
+
+        if ((_device != nullptr) && !_hibernated) {
+            timeout = Kernel::Clock::duration_u32(_idle_ms);
+        }
+
+        if (!_queue.try_get_for(timeout, &request)) {
+            if ((_device != nullptr) && !_hibernated) {
+                hibernate();
+            }
+            continue;
+        }
+
+        if (_hibernated) {
+            wake();
+        }
+
+        Request current = *request;
+        request->~Request();
+        _pool.free(request);
+
+        int result = current.command();
+
+        _mutex.lock();
+        _stats.commands++;
+        _mutex.unlock();
+
+        if (current.completion) {
+            current.completion(result);
+        }
+
+        if (current.done != nullptr) {
+            *current.result = result;
+            current.done->release();
+        }
+    }
+}
+
+void STSafeA110Dispatcher::hibernate()
+{
+    /* On failure the device stays awake and hibernation is tried again after the next idle time */
+    if (_device->hibernate() != 0) {
+        return;
+    }
+
+    Kernel::Clock::time_point now = Kernel::Clock::now();
+
+    _mutex.lock();
+    _stats.hibernations++;
+    _stats.awake_ms += (now - _state_time).count();
+    _state_time = now;
+    _hibernated = true;
+    _mutex.unlock();
+}
+
+void STSafeA110Dispatcher::wake()
+{
+    Timer timer;
+
+    /* Even if the wake-up fails, the first command polls the device until it answers */
+    timer.start();
+    _device->wake();
+    timer.stop();
+
+    uint32_t wake_us = timer.elapsed_time().count();
+    Kernel::Clock::time_point now = Kernel::Clock::now();
+
+    _mutex.lock();
+    _stats.wakes++;
+    _stats.wake_us += wake_us;
+    if (wake_us > _stats.wake_max_us) {
+        _stats.wake_max_us = wake_us;
+    }
+    _stats.hibernated_ms += (now - _state_time).count();
+    _state_time = now;
+    _hibernated = false;
+    _mutex.unlock();
+}
+
+} // namespace sixtron
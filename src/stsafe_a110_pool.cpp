@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafe_a110/stsafe_a110_pool.h"
+
+namespace sixtron {
+
+static_assert(MBED_CONF_STM_STSAFE_A110_POOL_MAX_DEVICES <= 32, "device masks are 32-bit wide");
+
+STSafeA110Pool::STSafeA110Pool(): _device_number(0), _next(0), _reset_time(Kernel::Clock::now())
+{
+    for (uint8_t i = 0; i < KeySlotNumber; i++) {
+        _key_slot_affinity[i] = 0xFFFFFFFF;
+    }
+}
+
+int STSafeA110Pool::add(STSafeA110Base *device, STSafeA110Dispatcher *dispatcher)
+{
+    int index = -1;
+
+    _mutex.lock();
+    if (_device_number < MBED_CONF_STM_STSAFE_A110_POOL_MAX_DEVICES) {
+        index = _device_number;
+        _devices[index] = Device { device, dispatcher, 0, 0, 0, 0 };
+        _device_number++;
+    }
+    _mutex.unlock();
+
+    return index;
+}
+
+int STSafeA110Pool::set_key_slot_affinity(uint8_t key_slot, uint32_t device_mask)
+{
+    int index = key_slot_index(key_slot);
+
+    if (index < 0) {
+        return -1;
+    }
+
+    _mutex.lock();
+    _key_slot_affinity[index] = device_mask;
+    _mutex.unlock();
+
+    return 0;
+}
+
+int STSafeA110Pool::generate_random(uint8_t *buf, uint8_t length, Completion completion)
+{
+    Job job = {};
+    job.operation = OperationRandom;
+    job.length = length;
+    job.output_1 = buf;
+    job.completion = completion;
+
+    return submit(job, 0xFFFFFFFF);
+}
+
+int STSafeA110Pool::generate_signature(uint8_t key_slot,
+        const uint8_t *digest,
+        StSafeA_HashTypes_t digest_type,
+        uint8_t *r,
+        uint8_t *s,
+        Completion completion)
+{
+    int index = key_slot_index(key_slot);
+    Job job = {};
+
+    if (index < 0) {
+        return -1;
+    }
+
+    job.operation = OperationSignature;
+    job.key_slot = key_slot;
+    job.digest_type = digest_type;
+    job.input_1 = digest;
+    job.output_1 = r;
+    job.output_2 = s;
+    job.completion = completion;
+
+    return submit(job, _key_slot_affinity[index]);
+}
+
+int STSafeA110Pool::establish_key(uint8_t key_slot,
+        const uint8_t *public_x,
+        const uint8_t *public_y,
+        uint16_t length,
+        uint8_t *shared_secret,
+        Completion completion)
+{
+    int index = key_slot_index(key_slot);
+    Job job = {};
+
+    if (index < 0) {
+        return -1;
+    }
+
+    job.operation = OperationEstablishKey;
+    job.key_slot = key_slot;
+    job.length = length;
+    job.input_1 = public_x;
+    job.input_2 = public_y;
+    job.output_1 = shared_secret;
+    job.completion = completion;
+
+    return submit(job, _key_slot_affinity[index]);
+}
+
+int STSafeA110Pool::get_utilization(int index, Utilization *utilization)
+{
+    if ((index < 0) || (index >= _device_number) || (utilization == nullptr)) {
+        return -1;
+    }
+
+    _mutex.lock();
+    utilization->commands = _devices[index].commands;
+    utilization->errors = _devices[index].errors;
+    utilization->outstanding = _devices[index].outstanding;
+    utilization->busy_ms = _devices[index].busy_ms;
+    utilization->elapsed_ms = (Kernel::Clock::now() - _reset_time).count();
+    _mutex.unlock();
+
+    return 0;
+}
+
+void STSafeA110Pool::reset_utilization()
+{
+    _mutex.lock();
+    for (uint8_t i = 0; i < _device_number; i++) {
+        _devices[i].commands = 0;
+        _devices[i].errors = 0;
+        _devices[i].busy_ms = 0;
+    }
+    _reset_time = Kernel::Clock::now();
+    _mutex.unlock();
+}
+
+int STSafeA110Pool::key_slot_index(uint8_t key_slot)
+{
+    switch (key_slot) {
+        case STSAFEA_KEY_SLOT_0:
+            return 0;
+        case STSAFEA_KEY_SLOT_1:
+            return 1;
+        case STSAFEA_KEY_SLOT_EPHEMERAL:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+/* Queue a job on the least loaded eligible device, and wait for it if it has no completion */
+int STSafeA110Pool::submit(const Job &job, uint32_t device_mask)
+{
+    Semaphore done(0, 1);
+    int result = -1;
+    int selected = -1;
+    Job *request;
+
+    _mutex.lock();
+    /* Ties are broken round robin, so that idle devices share the load */
+    for (uint8_t i = 0; i < _device_number; i++) {
+        uint8_t index = (_next + i) % _device_number;
+
+        if ((device_mask & (1UL << index)) == 0) {
+            continue;
+        }
+
+        if ((selected < 0) || (_devices[index].outstanding < _devices[selected].outstanding)) {
+            selected = index;
+        }
+    }
+
+    if (selected >= 0) {
+        _devices[selected].outstanding++;
+        _next = (selected + 1) % _device_number;
+    }
+    _mutex.unlock();
+
+    if (selected < 0) {
+        return -1;
+    }
+
+    request = _jobs.try_alloc();
+    if (request != nullptr) {
+        new (request) Job(job);
+        request->pool = this;
+        request->device = selected;
+
+        /* From a completion of the selected device, its worker would wait for itself: the job
+         * runs inline instead, the device being already awake */
+        if (!job.completion && _devices[selected].dispatcher->is_worker_thread()) {
+            return request->run();
+        }
+
+        if (!job.completion) {
+            request->done = &done;
+            request->result = &result;
+        }
+
+        if (_devices[selected].dispatcher->post(callback(request, &Job::run), nullptr) != 0) {
+            request->~Job();
+            _jobs.free(request);
+            request = nullptr;
+        }
+    }
+
+    if (request == nullptr) {
+        _mutex.lock();
+        _devices[selected].outstanding--;
+        _mutex.unlock();
+        return -1;
+    }
+
+    /* The request may already be freed here, only use the local copy */
+    if (job.completion) {
+        return 0;
+    }
+
+    done.acquire();
+
+    return result;
+}
+
+int STSafeA110Pool::Job::run()
+{
+    return pool->execute(this);
+}
+
+/* Runs on the dispatcher thread of the selected device */
+int STSafeA110Pool::execute(Job *job)
+{
+    Device *device = &_devices[job->device];
+    Kernel::Clock::time_point start = Kernel::Clock::now();
+    int result;
+
+    switch (job->operation) {
+        case OperationRandom:
+            result = device->device->generate_random(job->output_1, job->length);
+            break;
+        case OperationSignature:
+            result = device->device->generate_signature(
+                    job->key_slot, job->input_1, job->digest_type, job->output_1, job->output_2);
+            break;
+        case OperationEstablishKey:
+            result = device->device->establish_key(
+                    job->key_slot, job->input_1, job->input_2, job->length, job->output_1);
+            break;
+        default:
+            result = -1;
+            break;
+    }
+
+    uint32_t busy_ms = (Kernel::Clock::now() - start).count();
+
+    _mutex.lock();
+    device->outstanding--;
+    device->commands++;
+    if (result != 0) {
+        device->errors++;
+    }
+    device->busy_ms += busy_ms;
+    _mutex.unlock();
+
+    Completion completion = job->completion;
+    Semaphore *done = job->done;
+    int *job_result = job->result;
+
+    job->~Job();
+    _jobs.free(job);
+
+    if (completion) {
+        completion(result);
+    }
+
+    if (done != nullptr) {
+        *job_result = result;
+        done->release();
+    }
+
+    return result;
+}
+
+} // namespace sixtron
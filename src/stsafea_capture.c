@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafea_capture.h"
+#include "stsafea_service.h"
+
+#include <string.h>
+
+/* Type, status and two varints of up to 5 bytes */
+#define RECORD_HEADER_MAX_LENGTH 12U
+
+/* Response header: status and length */
+#define FRAME_HEADER_LENGTH 3U
+
+static uint8_t put_varint(uint8_t *p, uint32_t value)
+{
+    uint8_t length = 0;
+
+    do {
+        p[length] = (uint8_t)(value & 0x7FU);
+        value >>= 7;
+        if (value != 0U) {
+            p[length] |= 0x80U;
+        }
+        length++;
+    } while (value != 0U);
+
+    return length;
+}
+
+static int get_varint(const uint8_t *trace, uint32_t length, uint32_t *offset, uint32_t *value)
+{
+    *value = 0;
+
+    for (uint8_t shift = 0; shift < 35U; shift += 7U) {
+        uint8_t byte;
+        if (*offset >= length) {
+            return -1;
+        }
+        byte = trace[(*offset)++];
+        *value |= (uint32_t)(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0U) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static void record(stsafea_capture_t *capture,
+        uint8_t type,
+        int32_t status,
+        uint16_t length,
+        const uint8_t *data,
+        uint16_t data_length)
+{
+    uint8_t header[RECORD_HEADER_MAX_LENGTH];
+    uint32_t now = (capture->time_get_us != NULL) ? capture->time_get_us() : 0U;
+    uint8_t header_length = 0;
+
+    if (data == NULL) {
+        data_length = 0;
+    }
+
+    header[header_length++] = type;
+    header[header_length++] = (uint8_t)(int8_t)status;
+    header_length += put_varint(&header[header_length], now - capture->last_us);
+    header_length += put_varint(&header[header_length], length);
+
+    /* Once a record is dropped, the following ones would not replay */
+    if ((capture->dropped != 0U)
+            || (capture->length + header_length + data_length > capture->size)) {
+        capture->dropped++;
+        return;
+    }
+
+    memcpy(&capture->buffer[capture->length], header, header_length);
+    if (data_length != 0U) {
+        memcpy(&capture->buffer[capture->length + header_length], data, data_length);
+    }
+    capture->length += header_length + data_length;
+    capture->last_us = now;
+}
+
+static int32_t capture_send(void *pBusCtx, uint16_t address, uint8_t *pData, uint16_t Length)
+{
+    stsafea_capture_t *capture = (stsafea_capture_t *)pBusCtx;
+    int32_t status = capture->bus_send(capture->bus_ctx, address, pData, Length);
+
+    record(capture,
+            STSAFEA_CAPTURE_SEND,
+            status,
+            Length,
+            (status == STSAFEA_BUS_OK) ? pData : NULL,
+            Length);
+
+    return status;
+}
+
+static int32_t capture_recv(void *pBusCtx, uint16_t address, uint8_t *pData, uint16_t Length)
+{
+    stsafea_capture_t *capture = (stsafea_capture_t *)pBusCtx;
+    int32_t status = capture->bus_recv(capture->bus_ctx, address, pData, Length);
+
+    record(capture,
+            STSAFEA_CAPTURE_RECV,
+            status,
+            Length,
+            (status == STSAFEA_BUS_OK) ? pData : NULL,
+            Length);
+
+    return status;
+}
+
+static int32_t capture_recv_frame(
+        void *pBusCtx, uint16_t address, uint8_t *pData, uint16_t Length, uint16_t *pCrc)
+{
+    stsafea_capture_t *capture = (stsafea_capture_t *)pBusCtx;
+    int32_t status = capture->bus_recv_frame(capture->bus_ctx, address, pData, Length, pCrc);
+    uint32_t frame_length = Length;
+
+    /* Only the announced length was read */
+    if ((status == STSAFEA_BUS_OK) && (Length >= FRAME_HEADER_LENGTH)) {
+        frame_length = FRAME_HEADER_LENGTH + (((uint32_t)pData[1] << 8) | pData[2]);
+        if (frame_length > Length) {
+            frame_length = Length;
+        }
+    }
+
+    record(capture,
+            STSAFEA_CAPTURE_RECV_FRAME,
+            status,
+            Length,
+            (status == STSAFEA_BUS_OK) ? pData : NULL,
+            (uint16_t)frame_length);
+
+    return status;
+}
+
+static void capture_delay(void *pBusCtx, uint32_t msDelay)
+{
+    stsafea_capture_t *capture = (stsafea_capture_t *)pBusCtx;
+
+    if (capture->bus_delay != NULL) {
+        capture->bus_delay(capture->bus_ctx, msDelay);
+    } else {
+        capture->hw->TimeDelay(msDelay);
+    }
+    record(capture, STSAFEA_CAPTURE_DELAY, STSAFEA_BUS_OK, (uint16_t)msDelay, NULL, 0);
+}
+
+void stsafea_capture_start(
+        stsafea_capture_t *capture, StSafeA_Handle_t *handle, uint8_t *buffer, uint32_t size)
+{
+    STSAFEA_HW_t *hw = &handle->HwCtx;
+
+    capture->bus_recv = hw->BusRecv;
+    capture->bus_send = hw->BusSend;
+    capture->bus_recv_frame = hw->BusRecvFrame;
+    capture->hw = hw;
+    capture->bus_delay = hw->BusDelay;
+    capture->time_get_us = hw->TimeGetUs;
+    capture->bus_ctx = hw->pBusCtx;
+    capture->buffer = buffer;
+    capture->size = size;
+    capture->length = 0;
+    capture->dropped = 0;
+    capture->last_us = (hw->TimeGetUs != NULL) ? hw->TimeGetUs() : 0U;
+
+    if (size >= STSAFEA_CAPTURE_MAGIC_LENGTH) {
+        memcpy(buffer, STSAFEA_CAPTURE_MAGIC, STSAFEA_CAPTURE_MAGIC_LENGTH);
+        capture->length = STSAFEA_CAPTURE_MAGIC_LENGTH;
+    } else {
+        capture->dropped = 1;
+    }
+
+    hw->BusRecv = capture_recv;
+    hw->BusSend = capture_send;
+    if (hw->BusRecvFrame != NULL) {
+        hw->BusRecvFrame = capture_recv_frame;
+    }
+    hw->BusDelay = capture_delay;
+    hw->pBusCtx = capture;
+}
+
+void stsafea_capture_stop(stsafea_capture_t *capture, StSafeA_Handle_t *handle)
+{
+    STSAFEA_HW_t *hw = &handle->HwCtx;
+
+    hw->BusRecv = capture->bus_recv;
+    hw->BusSend = capture->bus_send;
+    hw->BusRecvFrame = capture->bus_recv_frame;
+    hw->BusDelay = capture->bus_delay;
+    hw->pBusCtx = capture->bus_ctx;
+}
+
+int stsafea_capture_next(const uint8_t *trace,
+        uint32_t length,
+        uint32_t *offset,
+        stsafea_capture_record_t *record)
+{
+    uint32_t value;
+
+    if (*offset == 0U) {
+        if ((length < STSAFEA_CAPTURE_MAGIC_LENGTH)
+                || (memcmp(trace, STSAFEA_CAPTURE_MAGIC, STSAFEA_CAPTURE_MAGIC_LENGTH) != 0)) {
+            return -1;
+        }
+        *offset = STSAFEA_CAPTURE_MAGIC_LENGTH;
+    }
+    if (*offset >= length) {
+        return 0;
+    }
+    if (*offset + 2U > length) {
+        return -1;
+    }
+
+    record->type = trace[(*offset)++];
+    record->status = (int8_t)trace[(*offset)++];
+    if ((record->type < STSAFEA_CAPTURE_SEND) || (record->type > STSAFEA_CAPTURE_DELAY)
+            || (get_varint(trace, length, offset, &record->delta_us) != 0)
+            || (get_varint(trace, length, offset, &value) != 0) || (value > 0xFFFFU)) {
+        return -1;
+    }
+    record->length = (uint16_t)value;
+    record->data_length = 0;
+    record->data = NULL;
+
+    if ((record->type != STSAFEA_CAPTURE_DELAY) && (record->status == STSAFEA_BUS_OK)) {
+        record->data_length = record->length;
+        /* A frame read holds the announced length only */
+        if ((record->type == STSAFEA_CAPTURE_RECV_FRAME) && (record->length >= FRAME_HEADER_LENGTH)
+                && (*offset + FRAME_HEADER_LENGTH <= length)) {
+            uint32_t frame_length = FRAME_HEADER_LENGTH
+                    + (((uint32_t)trace[*offset + 1U] << 8) | trace[*offset + 2U]);
+            if (frame_length < record->length) {
+                record->data_length = (uint16_t)frame_length;
+            }
+        }
+        if (*offset + record->data_length > length) {
+            return -1;
+        }
+        record->data = &trace[*offset];
+        *offset += record->data_length;
+    }
+
+    return 1;
+}
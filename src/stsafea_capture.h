@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_CAPTURE_H_
+#define CATIE_SIXTRON_STSAFEA_CAPTURE_H_
+
+#include <stdint.h>
+
+#include "stsafea_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A capture is a binary trace of the bus and delay calls of a device: STSAFEA_CAPTURE_MAGIC, then
+ * one record per call:
+ *
+ *     type (1 byte), status (1 byte, int8), delta_us (varint), length (varint), data
+ *
+ * delta_us is the time since the previous record, from the TimeGetUs function of the device. For
+ * a transfer, length is the requested length and data the bytes written or read, present only if
+ * the call succeeded; a frame read records the bytes of the frame only. For a delay, length is the
+ * delay in ms and there is no data. Varints are little-endian base 128 (LEB128).
+ */
+#define STSAFEA_CAPTURE_MAGIC "STC1"
+#define STSAFEA_CAPTURE_MAGIC_LENGTH 4U
+
+typedef enum {
+    STSAFEA_CAPTURE_SEND = 1,
+    STSAFEA_CAPTURE_RECV,
+    STSAFEA_CAPTURE_RECV_FRAME,
+    STSAFEA_CAPTURE_DELAY,
+} stsafea_capture_type_t;
+
+typedef struct {
+    uint8_t type; /* stsafea_capture_type_t */
+    int8_t status; /* STSAFEA_BUS_OK, STSAFEA_BUS_NACK or STSAFEA_BUS_ERR */
+    uint32_t delta_us;
+    uint16_t length;
+    uint16_t data_length;
+    const uint8_t *data; /* Into the trace, NULL if there is no data */
+} stsafea_capture_record_t;
+
+typedef struct {
+    /* Functions and context of the device being captured */
+    int32_t (*bus_recv)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t);
+    int32_t (*bus_send)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t);
+    int32_t (*bus_recv_frame)(void *pBusCtx, uint16_t address, uint8_t *, uint16_t, uint16_t *pCrc);
+    void (*bus_delay)(void *pBusCtx, uint32_t msDelay);
+    uint32_t (*time_get_us)(void);
+    void *bus_ctx;
+    STSAFEA_HW_t *hw; /* TimeDelay delays when there is no bus_delay */
+
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t length; /* Of the trace in buffer */
+    uint32_t dropped; /* Records that did not fit, the trace ends at the first one */
+    uint32_t last_us;
+} stsafea_capture_t;
+
+/*
+ * Record the bus and delay calls of an initialized device into buffer, until
+ * stsafea_capture_stop(). Each device has its own capture, several can run at once.
+ */
+void stsafea_capture_start(
+        stsafea_capture_t *capture, StSafeA_Handle_t *handle, uint8_t *buffer, uint32_t size);
+
+/* Give the device its own functions back, the trace is the first capture->length bytes */
+void stsafea_capture_stop(stsafea_capture_t *capture, StSafeA_Handle_t *handle);
+
+/*
+ * Decode the record of a trace at *offset, which is moved to the next one. The first call must
+ * start at offset 0. Returns 1 if a record was decoded, 0 at the end of the trace, -1 if it is
+ * malformed.
+ */
+int stsafea_capture_next(const uint8_t *trace,
+        uint32_t length,
+        uint32_t *offset,
+        stsafea_capture_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_CAPTURE_H_
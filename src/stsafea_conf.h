@@ -55,7 +55,45 @@ extern "C" {
 
 /* Set to 1 to optimize RAM/Flash usage, when Host MAC and encryption features are not required
   (eg. Authentication use case) */
+#ifndef STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT
 #define STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT    1U
+#endif /* STSAFEA_USE_OPTIMIZATION_NO_HOST_MAC_ENCRYPT */
+
+/* Set to 1 to start polling the STSAFE-A for the response as soon as the command minimum waiting time
+   (STSAFEA_MS_MIN_WAIT_TIME_CMD_xxx) has elapsed, instead of always waiting for the worst case command
+   processing time (STSAFEA_MS_WAIT_TIME_CMD_xxx). The STSAFE-A NACKs its address while busy, so each
+   command completes as soon as the device is done */
+#define STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING       1U
+
+/* Set to 1 to learn the actual processing time of each command from the response polling, and to wait for a
+   percentile of the learned times (STSAFEA_LATENCY_MODEL_PERCENTILE) before polling, instead of the minimum
+   waiting time. The learned times are kept in the StSafeA_Handle_t and can be saved and restored with
+   StSafeA_GetLatencyModel / StSafeA_SetLatencyModel.
+   Requires STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING = 1 */
+#define STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME     1U
+
+#if (STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME) && !(STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING)
+#error "STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME requires STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING"
+#endif /* STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME */
+
+/* Set to 1 to count, per command code, the commands, bus retries, CRC errors, response re-reads, bytes transferred
+   and waiting time, retrieved with StSafeA_GetStatistics (about 900 bytes per StSafeA_Handle_t) */
+#ifndef STSAFEA_USE_STATISTICS
+#define STSAFEA_USE_STATISTICS                          0U
+#endif /* STSAFEA_USE_STATISTICS */
+
+/* Set to 1 to measure the host CPU time spent in the CRC, command copy, MAC and encryption code of the Middleware,
+   retrieved with StSafeA_GetProfile. Requires the CycleCount bus function for the times */
+#ifndef STSAFEA_USE_PROFILING
+#define STSAFEA_USE_PROFILING                           0U
+#endif /* STSAFEA_USE_PROFILING */
+
+/* Set to 1 to record the end of each phase of the commands (build, MAC, CRC, bus transfers, processing wait) with
+   a microsecond timestamp, in a ring buffer read with StSafeA_ReadTrace. Requires the TimeGetUs bus function.
+   Set to 0 to remove the tracing code and memory */
+#ifndef STSAFEA_USE_TRACE
+#define STSAFEA_USE_TRACE                               0U
+#endif /* STSAFEA_USE_TRACE */
 
 /* Set to 1 to expanse the "assert_param" macro in the STSAFE middleware code */
 #define STSAFEA_USE_FULL_ASSERT                         0U
@@ -71,6 +109,20 @@ extern "C" {
 /*#define STSAFEA_I2C_POLLING_MAX              2500U */
 /* I2C polling step in ms */
 /*#define STSAFEA_I2C_POLLING_STEP                3U */
+/* I2C polling step in ms while waiting for a response, if STSAFEA_USE_OPTIMIZATION_RESPONSE_POLLING = 1 */
+/*#define STSAFEA_I2C_RESPONSE_POLLING_STEP       1U */
+
+/* To tune the command processing time model, if STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME = 1 */
+/* Number of histogram bins per command */
+/*#define STSAFEA_LATENCY_MODEL_BIN_NUMBER        8U */
+/* Percentile of the learned processing times to wait for before polling */
+/*#define STSAFEA_LATENCY_MODEL_PERCENTILE       20U */
+/* Number of recorded responses needed before the learned times are used */
+/*#define STSAFEA_LATENCY_MODEL_MIN_SAMPLES       4U */
+
+/* To size the command phase trace, if STSAFEA_USE_TRACE = 1 */
+/* Number of trace entries, a power of 2 */
+/*#define STSAFEA_TRACE_RING_SIZE                64U */
 
 /**
   * @}
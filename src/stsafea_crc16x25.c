@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafea_crc16x25.h"
+
+#include <string.h>
+
+#if (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_STM32)
+#include "cmsis.h"
+#include "platform/mbed_critical.h"
+#if !defined(CRC_CR_POLYSIZE)
+#error "The CRC peripheral of this target has a fixed polynomial, select another CRC engine"
+#endif
+#elif (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_CLMUL)
+#if defined(__PCLMUL__) && defined(__SSE2__)
+#include <wmmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#else
+#error "The CLMUL CRC engine requires x86 PCLMULQDQ (-mpclmul) or ARMv8 PMULL (-march=armv8-a+crypto)"
+#endif
+#elif (STSAFEA_CRC16X25_ENGINE != STSAFEA_CRC16X25_ENGINE_TABLE)                                  \
+        && (STSAFEA_CRC16X25_ENGINE != STSAFEA_CRC16X25_ENGINE_SLICING_4)                         \
+        && (STSAFEA_CRC16X25_ENGINE != STSAFEA_CRC16X25_ENGINE_SLICING_8)
+#error "Unknown STSAFEA_CRC16X25_ENGINE"
+#endif
+
+#define STSAFEA_CRC16X25_REFLECTED_POLYNOMIAL 0x8408U
+
+#define STSAFEA_CRC16_X25_REFLECTED_LOOKUP_TABLE                                                   \
+    0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF, 0x8C48, 0x9DC1, 0xAF5A,        \
+            0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7, 0x1081, 0x0108, 0x3393, 0x221A, 0x56A5,        \
+            0x472C, 0x75B7, 0x643E, 0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF,        \
+            0xE876, 0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD, 0xAD4A,        \
+            0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5, 0x3183, 0x200A, 0x1291,        \
+            0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C, 0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF,        \
+            0xEA66, 0xD8FD, 0xC974, 0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732,        \
+            0x36BB, 0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3, 0x5285,        \
+            0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A, 0xDECD, 0xCF44, 0xFDDF,        \
+            0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72, 0x6306, 0x728F, 0x4014, 0x519D, 0x2522,        \
+            0x34AB, 0x0630, 0x17B9, 0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78,        \
+            0x9BF1, 0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738, 0xFFCF,        \
+            0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70, 0x8408, 0x9581, 0xA71A,        \
+            0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7, 0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64,        \
+            0x5FED, 0x6D76, 0x7CFF, 0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF,        \
+            0xE036, 0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E, 0xA50A,        \
+            0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5, 0x2942, 0x38CB, 0x0A50,        \
+            0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD, 0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF,        \
+            0xE226, 0xD0BD, 0xC134, 0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5,        \
+            0x4D7C, 0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3, 0x4A44,        \
+            0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB, 0xD68D, 0xC704, 0xF59F,        \
+            0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232, 0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1,        \
+            0x0D68, 0x3FF3, 0x2E7A, 0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238,        \
+            0x93B1, 0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9, 0xF78F,        \
+            0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330, 0x7BC7, 0x6A4E, 0x58D5,        \
+            0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+
+#if (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_TABLE)
+static const uint16_t crc16_reflected_lookup_table[256]
+        = { STSAFEA_CRC16_X25_REFLECTED_LOOKUP_TABLE };
+#elif (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_SLICING_4)                              \
+        || (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_SLICING_8)
+#define STSAFEA_CRC16X25_SLICES ((STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_SLICING_8) ? 8 : 4)
+
+/* crc16_slicing_table[n][b] is the CRC register contribution of byte b followed by n zero bytes */
+static uint16_t crc16_slicing_table[STSAFEA_CRC16X25_SLICES][256];
+static const uint16_t crc16_reflected_lookup_table[256]
+        = { STSAFEA_CRC16_X25_REFLECTED_LOOKUP_TABLE };
+#endif
+
+#if (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_CLMUL)
+static inline uint16_t crc16_update_bitwise(uint16_t crc, uint8_t data)
+{
+    crc ^= data;
+    for (uint8_t bit = 8; bit > 0; bit--) {
+        if (crc & 1U) {
+            crc = (crc >> 1) ^ STSAFEA_CRC16X25_REFLECTED_POLYNOMIAL;
+        } else {
+            crc = (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+#endif
+
+#if (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_TABLE)
+int32_t stsafea_crc16x25_init(void)
+{
+    return 0;
+}
+
+uint16_t stsafea_crc16x25_update(uint16_t crc, uint8_t *dest, const uint8_t *data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t byte = data[i];
+        if (dest != NULL) {
+            dest[i] = byte;
+        }
+        crc = crc16_reflected_lookup_table[(crc ^ byte) & 0xFFU] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+#elif (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_SLICING_4)                              \
+        || (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_SLICING_8)
+int32_t stsafea_crc16x25_init(void)
+{
+    for (uint16_t b = 0; b < 256U; b++) {
+        crc16_slicing_table[0][b] = crc16_reflected_lookup_table[b];
+    }
+
+    for (uint8_t n = 1; n < STSAFEA_CRC16X25_SLICES; n++) {
+        for (uint16_t b = 0; b < 256U; b++) {
+            uint16_t crc = crc16_slicing_table[n - 1][b];
+            crc16_slicing_table[n][b] = crc16_reflected_lookup_table[crc & 0xFFU] ^ (crc >> 8);
+        }
+    }
+
+    return 0;
+}
+
+uint16_t stsafea_crc16x25_update(uint16_t crc, uint8_t *dest, const uint8_t *data, uint16_t length)
+{
+    /* The 16-bit register only overlaps the first two bytes of each slice */
+    while (length >= STSAFEA_CRC16X25_SLICES) {
+#if (STSAFEA_CRC16X25_SLICES == 8)
+        crc = crc16_slicing_table[7][(crc ^ data[0]) & 0xFFU]
+                ^ crc16_slicing_table[6][((crc >> 8) ^ data[1]) & 0xFFU]
+                ^ crc16_slicing_table[5][data[2]] ^ crc16_slicing_table[4][data[3]]
+                ^ crc16_slicing_table[3][data[4]] ^ crc16_slicing_table[2][data[5]]
+                ^ crc16_slicing_table[1][data[6]] ^ crc16_slicing_table[0][data[7]];
+#else
+        crc = crc16_slicing_table[3][(crc ^ data[0]) & 0xFFU]
+                ^ crc16_slicing_table[2][((crc >> 8) ^ data[1]) & 0xFFU]
+                ^ crc16_slicing_table[1][data[2]] ^ crc16_slicing_table[0][data[3]];
+#endif
+        if (dest != NULL) {
+            memcpy(dest, data, STSAFEA_CRC16X25_SLICES);
+            dest += STSAFEA_CRC16X25_SLICES;
+        }
+        data += STSAFEA_CRC16X25_SLICES;
+        length -= STSAFEA_CRC16X25_SLICES;
+    }
+
+    while (length > 0U) {
+        crc = crc16_slicing_table[0][(crc ^ *data) & 0xFFU] ^ (crc >> 8);
+        if (dest != NULL) {
+            *dest++ = *data;
+        }
+        data++;
+        length--;
+    }
+
+    return crc;
+}
+
+#elif (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_STM32)
+int32_t stsafea_crc16x25_init(void)
+{
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    return 0;
+}
+
+uint16_t stsafea_crc16x25_update(uint16_t crc, uint8_t *dest, const uint8_t *data, uint16_t length)
+{
+    uint32_t word;
+
+    /* The peripheral is shared by all the devices, and possibly by other drivers */
+    core_util_critical_section_enter();
+
+    /* 16-bit polynomial 0x1021, bit-reversed input bytes and output: the reflected CRC16-X25.
+     * The peripheral holds the register unreflected, so a running value is reversed back. */
+    CRC->POL = 0x1021U;
+    CRC->INIT = __RBIT(crc) >> 16;
+    CRC->CR = CRC_CR_POLYSIZE_0 | CRC_CR_REV_IN_0 | CRC_CR_REV_OUT | CRC_CR_RESET;
+
+    /* Words are processed most significant byte first */
+    while (length >= 4U) {
+        memcpy(&word, data, sizeof(word));
+        CRC->DR = __REV(word);
+        if (dest != NULL) {
+            memcpy(dest, &word, sizeof(word));
+            dest += 4;
+        }
+        data += 4;
+        length -= 4U;
+    }
+
+    while (length > 0U) {
+        *(__IO uint8_t *)&CRC->DR = *data;
+        if (dest != NULL) {
+            *dest++ = *data;
+        }
+        data++;
+        length--;
+    }
+
+    crc = (uint16_t)CRC->DR;
+
+    core_util_critical_section_exit();
+
+    return crc;
+}
+
+#elif (STSAFEA_CRC16X25_ENGINE == STSAFEA_CRC16X25_ENGINE_CLMUL)
+/*
+ * Data is processed in 64-bit chunks T, taken in the bit-reflected domain of the CRC. With
+ * mu = x^80 / P = x^64 + mu_low, the Barrett quotient of T.x^16 by P is q = T + (T.mu_low / x^64)
+ * and the new register is (q.P mod x^16). In the reflected domain, each product is a single
+ * carry-less multiplication, shifted by one bit.
+ */
+#define STSAFEA_CRC16X25_CLMUL_MU 0xC2CD82058E2C0C88ULL /* reflected mu_low */
+#define STSAFEA_CRC16X25_CLMUL_P 0x10811ULL /* reflected x^16 + 0x1021 */
+
+#if defined(__PCLMUL__)
+static inline void clmul64(uint64_t a, uint64_t b, uint64_t *low, uint64_t *high)
+{
+    __m128i product = _mm_clmulepi64_si128(
+            _mm_cvtsi64_si128((long long)a), _mm_cvtsi64_si128((long long)b), 0x00);
+
+    *low = (uint64_t)_mm_cvtsi128_si64(product);
+    *high = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product));
+}
+#else
+static inline void clmul64(uint64_t a, uint64_t b, uint64_t *low, uint64_t *high)
+{
+    poly128_t product = vmull_p64((poly64_t)a, (poly64_t)b);
+
+    *low = vgetq_lane_u64(vreinterpretq_u64_p128(product), 0);
+    *high = vgetq_lane_u64(vreinterpretq_u64_p128(product), 1);
+}
+#endif
+
+int32_t stsafea_crc16x25_init(void)
+{
+    return 0;
+}
+
+uint16_t stsafea_crc16x25_update(uint16_t crc, uint8_t *dest, const uint8_t *data, uint16_t length)
+{
+    uint64_t chunk, low, high;
+
+    while (length >= 8U) {
+        memcpy(&chunk, data, sizeof(chunk));
+        if (dest != NULL) {
+            memcpy(dest, &chunk, sizeof(chunk));
+            dest += 8;
+        }
+        chunk ^= crc;
+
+        clmul64(chunk, STSAFEA_CRC16X25_CLMUL_MU, &low, &high);
+        chunk ^= (low << 1);
+        clmul64(chunk, STSAFEA_CRC16X25_CLMUL_P, &low, &high);
+        crc = (uint16_t)high;
+
+        data += 8;
+        length -= 8U;
+    }
+
+    while (length > 0U) {
+        crc = crc16_update_bitwise(crc, *data);
+        if (dest != NULL) {
+            *dest++ = *data;
+        }
+        data++;
+        length--;
+    }
+
+    return crc;
+}
+#endif
+
+uint16_t stsafea_crc16x25_compute(uint8_t header, const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = stsafea_crc16x25_update(0xFFFF, NULL, &header, 1);
+
+    return stsafea_crc16x25_update(crc, NULL, data, length);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_CRC16X25_H_
+#define CATIE_SIXTRON_STSAFEA_CRC16X25_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Byte-wise lookup table in flash (512 bytes) */
+#define STSAFEA_CRC16X25_ENGINE_TABLE 1
+/* Slicing-by-4 lookup tables built in RAM by stsafea_crc16x25_init (2 KB) */
+#define STSAFEA_CRC16X25_ENGINE_SLICING_4 2
+/* Slicing-by-8 lookup tables built in RAM by stsafea_crc16x25_init (4 KB) */
+#define STSAFEA_CRC16X25_ENGINE_SLICING_8 3
+/* STM32 CRC peripheral with a programmable polynomial (not available on F1/F2/F4/L1) */
+#define STSAFEA_CRC16X25_ENGINE_STM32 4
+/* Carry-less multiplication, x86 PCLMULQDQ or ARMv8 PMULL (crypto extension) */
+#define STSAFEA_CRC16X25_ENGINE_CLMUL 5
+
+#ifndef STSAFEA_CRC16X25_ENGINE
+#ifdef MBED_CONF_STM_STSAFE_A110_CRC_ENGINE
+#define STSAFEA_CRC16X25_ENGINE MBED_CONF_STM_STSAFE_A110_CRC_ENGINE
+#else
+#define STSAFEA_CRC16X25_ENGINE STSAFEA_CRC16X25_ENGINE_TABLE
+#endif
+#endif
+
+/* Prepare the selected engine, must be called before computing a CRC. Returns 0. */
+int32_t stsafea_crc16x25_init(void);
+
+/*
+ * Run the CRC16-X25 (reflected polynomial 0x8408, initial value 0xFFFF) over the header byte
+ * followed by length bytes of data. Returns the CRC register, before the final inversion.
+ */
+uint16_t stsafea_crc16x25_compute(uint8_t header, const uint8_t *data, uint16_t length);
+
+/*
+ * Continue a CRC16-X25 register with length bytes of data, also copying them to dest when it is
+ * not NULL, so that a buffer is filled and checksummed in a single pass. Returns the register.
+ */
+uint16_t stsafea_crc16x25_update(uint16_t crc, uint8_t *dest, const uint8_t *data, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_CRC16X25_H_
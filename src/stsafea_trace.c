@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stsafea_trace.h"
+
+#if STSAFEA_USE_TRACE
+
+/* Entries moved out of the ring at once */
+#define STSAFEA_TRACE_DUMP_CHUNK 16
+
+static const char *const phase_names[] = {
+    "start",
+    "build",
+    "mac_pre",
+    "crc",
+    "bus_write",
+    "wait",
+    "bus_read",
+    "crc_check",
+    "mac_post",
+    "end",
+};
+
+const char *stsafea_trace_phase_name(uint8_t phase)
+{
+    if (phase >= (sizeof(phase_names) / sizeof(phase_names[0]))) {
+        return "?";
+    }
+
+    return phase_names[phase];
+}
+
+int stsafea_trace_dump(StSafeA_Handle_t *handle, FILE *stream)
+{
+    StSafeA_TraceEntry_t entries[STSAFEA_TRACE_DUMP_CHUNK];
+    uint16_t number;
+    uint32_t dropped;
+    uint32_t previous = 0;
+    int written = 0;
+
+    if (stream == NULL) {
+        return -1;
+    }
+
+    do {
+        if (StSafeA_ReadTrace(handle, entries, STSAFEA_TRACE_DUMP_CHUNK, &number, &dropped)
+                != STSAFEA_OK) {
+            return -1;
+        }
+
+        for (uint16_t i = 0; i < number; i++) {
+            const StSafeA_TraceEntry_t *entry = &entries[i];
+            uint32_t duration = ((entry->Phase == STSAFEA_TRACE_PHASE_START) || (written == 0))
+                    ? 0
+                    : entry->Timestamp - previous;
+
+            fprintf(stream,
+                    "%lu,0x%02X,%s,%u,%lu\n",
+                    (unsigned long)entry->Timestamp,
+                    entry->Header,
+                    stsafea_trace_phase_name(entry->Phase),
+                    entry->Value,
+                    (unsigned long)duration);
+            previous = entry->Timestamp;
+            written++;
+        }
+    } while (number == STSAFEA_TRACE_DUMP_CHUNK);
+
+    if (dropped != 0) {
+        fprintf(stream, "# %lu entries dropped since the initialization\n", (unsigned long)dropped);
+    }
+
+    return written;
+}
+
+#endif // STSAFEA_USE_TRACE
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA_TRACE_H_
+#define CATIE_SIXTRON_STSAFEA_TRACE_H_
+
+#include <stdio.h>
+
+#include "stsafea_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if STSAFEA_USE_TRACE
+/* Name of a StSafeA_TracePhase_t, "?" if unknown */
+const char *stsafea_trace_phase_name(uint8_t phase);
+
+/*
+ * Move all the trace entries of the device to stream, one CSV line per phase:
+ * "timestamp_us,header,phase,value,duration_us", the duration being measured from the previous
+ * entry of the same command. Callable from another thread than the one sending the commands.
+ * Returns the number of entries written, -1 on error.
+ */
+int stsafea_trace_dump(StSafeA_Handle_t *handle, FILE *stream);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CATIE_SIXTRON_STSAFEA_TRACE_H_
@@ -6,14 +6,188 @@
 #define CATIE_SIXTRON_STSAFEA110_H_
 
 #include "mbed.h"
+#include "stsafe_a110/stsafe_a110_bus.h"
+#include "stsafea_capture.h"
+#include "stsafea_core.h"
 
 namespace sixtron {
 
-class STSafeA110 {
+/* Data bytes of the command or response of the operations, to size an STSafeA110Sized */
+struct STSafeA110Payload {
+    static constexpr uint16_t echo(uint16_t length)
+    {
+        return length;
+    }
+
+    static constexpr uint16_t generate_random(uint16_t length)
+    {
+        return length;
+    }
+
+    static constexpr uint16_t read_data_partition(uint16_t length)
+    {
+        return length;
+    }
+
+    /* Flags, zone index and offset in front of the data */
+    static constexpr uint16_t update_data_partition(uint16_t length)
+    {
+        return 4 + length;
+    }
+
+    /* R and S, each with its length */
+    static constexpr uint16_t generate_signature(StSafeA_HashTypes_t digest_type)
+    {
+        return 2
+                * (STSAFEA_LENGTH_SIZE
+                        + ((digest_type == STSAFEA_SHA_384) ? STSAFEA_XYRS_ECDSA_SHA384_LENGTH
+                                                            : STSAFEA_XYRS_ECDSA_SHA256_LENGTH));
+    }
+
+    /* Key slot, point representation, X and Y each with its length */
+    static constexpr uint16_t establish_key(uint16_t length)
+    {
+        return 2 + 2 * (STSAFEA_LENGTH_SIZE + length);
+    }
+};
+
+/* Non-owning view of size elements at data, built from a pointer and a size or from an array. Spans
+ * of uint8_t convert to spans of const uint8_t. */
+template <typename T> class STSafeA110Span {
+
+public:
+    constexpr STSafeA110Span(): _data(nullptr), _size(0)
+    {
+    }
+
+    constexpr STSafeA110Span(T *data, size_t size): _data(data), _size(size)
+    {
+    }
+
+    template <size_t N> constexpr STSafeA110Span(T (&array)[N]): _data(array), _size(N)
+    {
+    }
+
+    template <typename U>
+    constexpr STSafeA110Span(const STSafeA110Span<U> &other):
+            _data(other.data()), _size(other.size())
+    {
+    }
+
+    constexpr T *data() const
+    {
+        return _data;
+    }
+
+    constexpr size_t size() const
+    {
+        return _size;
+    }
+
+    constexpr T *begin() const
+    {
+        return _data;
+    }
+
+    constexpr T *end() const
+    {
+        return _data + _size;
+    }
+
+private:
+    T *_data;
+    size_t _size;
+};
+
+/* Outcome of an operation: the response code of the middleware and, on success, the number of
+ * elements written to the output span */
+class STSafeA110Result {
+
+public:
+    constexpr STSafeA110Result(StSafeA_ResponseCode_t code = STSAFEA_OK, uint16_t length = 0):
+            _code(code), _length(length)
+    {
+    }
+
+    constexpr StSafeA_ResponseCode_t code() const
+    {
+        return _code;
+    }
+
+    constexpr bool ok() const
+    {
+        return _code == STSAFEA_OK;
+    }
+
+    constexpr explicit operator bool() const
+    {
+        return ok();
+    }
+
+    constexpr uint16_t length() const
+    {
+        return _length;
+    }
+
+private:
+    StSafeA_ResponseCode_t _code;
+    uint16_t _length;
+};
+
+/* Response data left in place in the I/O buffer of a driver, instead of being copied. The view goes
+ * stale at the next command of the driver, which overwrites the buffer: data() then returns
+ * nullptr and size() 0. With several threads, only the thread sending the commands may use it. */
+class STSafeA110View {
 
 public:
-    STSafeA110();
+    STSafeA110View(): _handle(nullptr), _data(nullptr), _size(0), _generation(0)
+    {
+    }
+
+    bool valid() const
+    {
+        return (_handle != nullptr) && (_handle->CommandCounter == _generation);
+    }
+
+    const uint8_t *data() const
+    {
+        return valid() ? _data : nullptr;
+    }
+
+    uint16_t size() const
+    {
+        return valid() ? _size : 0;
+    }
+
+    const uint8_t *begin() const
+    {
+        return data();
+    }
+
+    const uint8_t *end() const
+    {
+        return data() + size();
+    }
 
+private:
+    friend class STSafeA110Base;
+
+    STSafeA110View(const StSafeA_Handle_t *handle, const uint8_t *data, uint16_t size):
+            _handle(handle), _data(data), _size(size), _generation(handle->CommandCounter)
+    {
+    }
+
+    const StSafeA_Handle_t *_handle;
+    const uint8_t *_data;
+    uint16_t _size;
+    uint32_t _generation;
+};
+
+/* Secure element driver, using the I/O buffer of the STSafeA110Sized it is part of. Not copyable,
+ * as its handle points into that buffer. */
+class STSafeA110Base: private NonCopyable<STSafeA110Base> {
+
+public:
     int init();
 
     int echo(uint8_t *buffer_in, uint8_t *buffer_out, size_t length);
@@ -21,8 +195,246 @@ public:
     int update_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length);
 
     int read_data_partition(uint8_t zone_index, uint8_t *buf, uint16_t length);
+
+    int generate_random(uint8_t *buf, uint8_t length);
+
+    /* Zero-copy variants: the response is left in the I/O buffer, see STSafeA110View */
+    int read_data_partition(
+            uint8_t zone_index, uint16_t offset, uint16_t length, STSafeA110View *view);
+
+    int generate_random(uint8_t length, STSafeA110View *view);
+
+    int generate_signature(uint8_t key_slot,
+            const uint8_t *digest,
+            StSafeA_HashTypes_t digest_type,
+            STSafeA110View *r,
+            STSafeA110View *s);
+
+    /* r and s must each hold 32 bytes for SHA-256 digests, 48 bytes for SHA-384 digests */
+    int generate_signature(uint8_t key_slot,
+            const uint8_t *digest,
+            StSafeA_HashTypes_t digest_type,
+            uint8_t *r,
+            uint8_t *s);
+
+    int establish_key(uint8_t key_slot,
+            const uint8_t *public_x,
+            const uint8_t *public_y,
+            uint16_t length,
+            uint8_t *shared_secret);
+
+    /* Typed API: spans in and out, STSafeA110Result back. Coordinates, signature halves, digests
+     * and shared secrets are 32 bytes on 256-bit curves and 48 bytes on 384-bit curves, other
+     * sizes fail with STSAFEA_INVALID_PARAMETER. An array passed as such to generate_random
+     * selects the int overload of STSafeA110Sized, wrap it in an STSafeA110Span. */
+    STSafeA110Result generate_random(STSafeA110Span<uint8_t> buffer);
+
+    /* Key pair usable for message signature and key establishment, length() is the coordinate
+     * size */
+    STSafeA110Result generate_key_pair(uint8_t key_slot,
+            StSafeA_CurveId_t curve,
+            STSafeA110Span<uint8_t> public_x,
+            STSafeA110Span<uint8_t> public_y,
+            uint8_t authorization_flags = STSAFEA_PRVKEY_MODOPER_AUTHFLAG_MSG_DGST_SIGNEN
+                    | STSAFEA_PRVKEY_MODOPER_AUTHFLAG_KEY_ESTABLISHEN,
+            uint16_t use_limit = 0xFFFF);
+
+    /* The digest size selects SHA-256 or SHA-384, length() is the size of r and of s */
+    STSafeA110Result generate_signature(uint8_t key_slot,
+            STSafeA110Span<const uint8_t> digest,
+            STSafeA110Span<uint8_t> r,
+            STSafeA110Span<uint8_t> s);
+
+    /* Succeeds whatever the verdict, which is written to valid */
+    STSafeA110Result verify_message_signature(StSafeA_CurveId_t curve,
+            STSafeA110Span<const uint8_t> public_x,
+            STSafeA110Span<const uint8_t> public_y,
+            STSafeA110Span<const uint8_t> r,
+            STSafeA110Span<const uint8_t> s,
+            STSafeA110Span<const uint8_t> digest,
+            bool *valid);
+
+    /* ECDH with the private key of key_slot, length() is the shared secret size */
+    STSafeA110Result establish_key(uint8_t key_slot,
+            STSafeA110Span<const uint8_t> public_x,
+            STSafeA110Span<const uint8_t> public_y,
+            STSafeA110Span<uint8_t> shared_secret);
+
+    STSafeA110Result generate_local_envelope_key(uint8_t key_slot, uint8_t key_type);
+
+    /* The envelope is 8 bytes longer than the data, a non-zero multiple of 8 bytes */
+    STSafeA110Result wrap_local_envelope(
+            uint8_t key_slot, STSafeA110Span<const uint8_t> data, STSafeA110Span<uint8_t> envelope);
+
+    STSafeA110Result unwrap_local_envelope(
+            uint8_t key_slot, STSafeA110Span<const uint8_t> envelope, STSafeA110Span<uint8_t> data);
+
+    /* Decrement the one way counter of a counter zone, writing data at offset in the same
+     * command, and return the new counter value */
+    STSafeA110Result decrement(uint8_t zone_index,
+            uint32_t amount,
+            uint32_t *counter,
+            STSafeA110Span<const uint8_t> data = STSafeA110Span<const uint8_t>(),
+            uint16_t offset = 0);
+
+    STSafeA110Result query_product_data(StSafeA_ProductDataBuffer_t *product_data);
+
+    /* length() is the number of zones. More zones than zones can hold fail with
+     * STSAFEA_INVALID_RESP_LENGTH. */
+    STSafeA110Result query_data_partition(
+            STSafeA110Span<StSafeA_ZoneInformationRecordBuffer_t> zones);
+
+    STSafeA110Result query_i2c_parameters(StSafeA_I2cParameterBuffer_t *parameters);
+
+    STSafeA110Result query_life_cycle_state(StSafeA_LifeCycleStateBuffer_t *state);
+
+    STSafeA110Result query_host_key_slot(StSafeA_HostKeySlotBuffer_t *slot);
+
+    STSafeA110Result query_local_envelope_key_slots(StSafeA_LocalEnvelopeKeyTableBuffer_t *table,
+            StSafeA_LocalEnvelopeKeyInformationRecordBuffer_t *slot_0,
+            StSafeA_LocalEnvelopeKeyInformationRecordBuffer_t *slot_1);
+
+    /* Put the device in its very low power mode. It wakes up on the next I2C start condition,
+     * with the state of a reset: the ephemeral key and the volatile settings are lost. */
+    int hibernate();
+
+    /* Wake the device up from hibernation, returns once it answers commands again */
+    int wake();
+
+    /* Select how busy device NACKs are retried, nullptr restores the default fixed polling */
+    int set_retry_policy(const StSafeA_RetryPolicy_t *policy);
+
+    /* Bound the time each following command waits for the device, 0 disables the deadline.
+     * A command reaching its deadline fails with STSAFEA_COMMUNICATION_TIMEOUT. */
+    int set_deadline(uint32_t deadline_ms);
+
+#if STSAFEA_USE_STATISTICS
+    /* Snapshot of the communication counters, per command code and in total */
+    int stats(StSafeA_Statistics_t *snapshot);
+
+    int reset_stats();
+#endif
+
+#if STSAFEA_USE_PROFILING
+    /* Snapshot of the CPU time spent in the middleware, see StSafeA_ProfileSection_t */
+    int get_profile(StSafeA_Profile_t *profile);
+
+    int reset_profile();
+#endif
+
+#if STSAFEA_USE_TRACE
+    /* Move the recorded command phases to stream as CSV lines, see stsafea_trace_dump() */
+    int dump_trace(FILE *stream = stdout);
+#endif
+
+    /* Record the bus calls of the following commands into buffer, see stsafea_capture.h. Not to be
+     * called while a command is running. */
+    int start_capture(uint8_t *buffer, uint32_t size);
+
+    /* Stop recording, returns the length of the capture or -1 if it overflowed the buffer */
+    int32_t stop_capture();
+
+#if STSAFEA_USE_OPTIMIZATION_ADAPTIVE_WAIT_TIME
+    int get_latency_model(StSafeA_LatencyModel_t *model);
+
+    int set_latency_model(const StSafeA_LatencyModel_t *model);
+#endif
+
+protected:
+    /** Create a secure element driver
+     *
+     * @param buffer I/O buffer of STSAFEA_BUFFER_SIZE(payload) bytes
+     * @param buffer_size size of buffer in bytes
+     * @param bus bus the device sits on, nullptr selects the default bus from the configuration
+     * @param address 7-bit I2C address, 0 selects the default address
+     */
+    STSafeA110Base(uint8_t *buffer, uint16_t buffer_size, STSafeA110Bus *bus, uint16_t address);
+
+private:
+    STSafeA110Bus *_bus;
+    uint16_t _address;
+    StSafeA_Handle_t _handle;
+    uint8_t *_buffer;
+    uint16_t _buffer_size;
+    stsafea_capture_t _capture;
+    bool _capturing;
+};
+
+/* Secure element driver whose I/O buffer holds commands and responses of up to MaxPayload data
+ * bytes, see STSafeA110Payload. Longer ones fail with STSAFEA_BUFFER_LENGTH_EXCEEDED, and those
+ * known at compile time do not build. */
+template <uint16_t MaxPayload> class STSafeA110Sized: public STSafeA110Base {
+    static_assert(MaxPayload >= STSAFEA_BUFFER_MIN_DATA_SIZE,
+            "payload below STSAFEA_BUFFER_MIN_DATA_SIZE");
+    static_assert(MaxPayload <= STSAFEA_BUFFER_DATA_CONTENT_SIZE,
+            "payload above STSAFEA_BUFFER_DATA_CONTENT_SIZE");
+
+public:
+    static constexpr uint16_t max_payload = MaxPayload;
+
+    /** Create a secure element driver
+     *
+     * @param bus bus the device sits on, nullptr selects the default bus from the configuration
+     * @param address 7-bit I2C address, 0 selects the default address
+     */
+    STSafeA110Sized(STSafeA110Bus *bus = nullptr, uint16_t address = 0):
+            STSafeA110Base(_storage, sizeof(_storage), bus, address)
+    {
+    }
+
+    using STSafeA110Base::echo;
+    using STSafeA110Base::generate_random;
+    using STSafeA110Base::generate_signature;
+    using STSafeA110Base::read_data_partition;
+    using STSafeA110Base::update_data_partition;
+
+    template <size_t N> int echo(const uint8_t (&buffer_in)[N], uint8_t (&buffer_out)[N])
+    {
+        static_assert(STSafeA110Payload::echo(N) <= MaxPayload, "echo does not fit the buffer");
+        return STSafeA110Base::echo(const_cast<uint8_t *>(buffer_in), buffer_out, N);
+    }
+
+    template <size_t N> int generate_random(uint8_t (&buf)[N])
+    {
+        static_assert(N <= UINT8_MAX, "random longer than 255 bytes");
+        static_assert(STSafeA110Payload::generate_random(N) <= MaxPayload,
+                "random does not fit the buffer");
+        return STSafeA110Base::generate_random(buf, N);
+    }
+
+    template <size_t N> int read_data_partition(uint8_t zone_index, uint8_t (&buf)[N])
+    {
+        static_assert(STSafeA110Payload::read_data_partition(N) <= MaxPayload,
+                "read does not fit the buffer");
+        return STSafeA110Base::read_data_partition(zone_index, buf, N);
+    }
+
+    template <size_t N> int update_data_partition(uint8_t zone_index, uint8_t (&buf)[N])
+    {
+        static_assert(STSafeA110Payload::update_data_partition(N) <= MaxPayload,
+                "update does not fit the buffer");
+        return STSafeA110Base::update_data_partition(zone_index, buf, N);
+    }
+
+    /* SHA-384 signatures need STSafeA110Payload::generate_signature(STSAFEA_SHA_384) */
+    int generate_signature(uint8_t key_slot,
+            const uint8_t *digest,
+            StSafeA_HashTypes_t digest_type,
+            uint8_t *r,
+            uint8_t *s)
+    {
+        static_assert(STSafeA110Payload::generate_signature(STSAFEA_SHA_256) <= MaxPayload,
+                "signature does not fit the buffer");
+        return STSafeA110Base::generate_signature(key_slot, digest, digest_type, r, s);
+    }
+
+private:
+    uint8_t _storage[STSAFEA_BUFFER_SIZE(MaxPayload)];
 };
 
+/* Secure element driver with a buffer for the largest commands and responses */
+typedef STSafeA110Sized<STSAFEA_BUFFER_DATA_CONTENT_SIZE> STSafeA110;
+
 } // namespace sixtron
 
 #endif // CATIE_SIXTRON_STSAFEA110_H_
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA110_BUS_H_
+#define CATIE_SIXTRON_STSAFEA110_BUS_H_
+
+#include "mbed.h"
+
+namespace sixtron {
+
+/*!
+ * Arbitrates an I2C bus between secure elements and the other peripherals sitting on it.
+ *
+ * Every transaction runs with the bus acquired, so the frames of the secure elements and the
+ * transactions of the other drivers never interleave. A secure element only holds the bus while
+ * a frame is transferred: it is released while the device processes a command and between two
+ * polls of a busy device, so the other peripherals keep being served during long commands.
+ *
+ * Other drivers either use the read() and write() wrappers, or surround the transactions that
+ * must not be interrupted with acquire() and release() and use the I2C object directly.
+ */
+class STSafeA110Bus: private NonCopyable<STSafeA110Bus> {
+
+public:
+    struct Occupancy {
+        uint32_t transactions; /* times the bus was acquired */
+        uint64_t busy_us; /* time the bus was held */
+        uint64_t wait_us; /* time spent waiting for the bus held by another thread */
+        uint32_t max_wait_us; /* longest wait for the bus */
+        uint32_t elapsed_ms; /* time since the statistics were reset */
+    };
+
+    STSafeA110Bus(I2C *i2c);
+
+    /* Bus on the pins of the configuration, used by the devices created without a bus */
+    static STSafeA110Bus *get_default();
+
+    I2C *i2c();
+
+    /* Take exclusive use of the bus, recursively */
+    void acquire();
+
+    void release();
+
+    /* I2C::write with the bus acquired, returns 0 on success. A successful repeated transfer
+     * sends no STOP and keeps the bus acquired until the next transfer without repeated. */
+    int write(int address, const char *data, int length, bool repeated = false);
+
+    /* I2C::read with the bus acquired, returns 0 on success. Same repeated rule as write(). */
+    int read(int address, char *data, int length, bool repeated = false);
+
+    int get_occupancy(Occupancy *occupancy);
+
+    void reset_occupancy();
+
+private:
+    void end_transfer(bool repeated);
+
+    I2C *_i2c;
+    Mutex _mutex;
+    uint32_t _depth;
+    bool _repeated;
+    uint32_t _acquire_time;
+    Occupancy _occupancy;
+    Kernel::Clock::time_point _reset_time;
+};
+
+} // namespace sixtron
+
+#endif // CATIE_SIXTRON_STSAFEA110_BUS_H_
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA110_DISPATCHER_H_
+#define CATIE_SIXTRON_STSAFEA110_DISPATCHER_H_
+
+#include "mbed.h"
+#include "stsafe_a110/stsafe_a110.h"
+
+namespace sixtron {
+
+/*!
+ * Serializes the secure element commands of several threads on a single worker thread.
+ *
+ * Commands are queued with a priority and executed one at a time, highest priority first, so
+ * that the device handle and its I/O buffer are only ever used by the worker thread. Once a
+ * dispatcher is started, every access to the device must go through it.
+ *
+ * With auto-hibernation enabled, the device is put in hibernation once the queue has stayed empty
+ * for the idle time, and woken up before the next command. Commands queued meanwhile all run
+ * within that single wake-up.
+ */
+class STSafeA110Dispatcher: private NonCopyable<STSafeA110Dispatcher> {
+
+public:
+    /* Command executed on the worker thread, returns 0 on success */
+    typedef Callback<int()> Command;
+    /* Called on the worker thread with the result of a posted command */
+    typedef Callback<void(int)> Completion;
+
+    enum Priority : uint8_t {
+        PriorityLow = 0,
+        PriorityNormal = 1,
+        PriorityHigh = 2,
+    };
+
+    struct PowerStats {
+        uint32_t hibernations; /* times the device was put in hibernation */
+        uint32_t wakes; /* times the device was woken up */
+        uint32_t commands; /* commands executed, commands / wakes is the batching achieved */
+        uint32_t wake_us; /* total time spent waking the device up */
+        uint32_t wake_max_us; /* longest wake-up */
+        uint32_t awake_ms; /* time spent awake, commands included */
+        uint32_t hibernated_ms; /* time spent in hibernation */
+    };
+
+    STSafeA110Dispatcher(osPriority thread_priority = osPriorityAboveNormal,
+            uint32_t stack_size = MBED_CONF_STM_STSAFE_A110_DISPATCHER_STACK_SIZE);
+
+    int start();
+
+    /* Hibernate device after idle_ms without command, 0 disables it. Call before start(). */
+    void enable_auto_hibernate(STSafeA110Base *device, uint32_t idle_ms);
+
+    int get_power_stats(PowerStats *stats);
+
+    void reset_power_stats();
+
+    int post(Command command, Completion completion, Priority priority = PriorityNormal);
+
+    /* Queue a command and wait for its result. From the worker thread itself, i.e. within a
+     * command or a completion, the command runs inline instead, ahead of the queued ones. */
+    int call(Command command, Priority priority = PriorityNormal);
+
+    /* True when called from the worker thread, i.e. within a command or a completion */
+    bool is_worker_thread() const;
+
+private:
+    struct Request {
+        Command command;
+        Completion completion;
+        Semaphore *done;
+        int *result;
+    };
+
+    void run();
+
+    void hibernate();
+
+    void wake();
+
+    int queue(Command command, Completion completion, Semaphore *done, int *result, Priority priority);
+
+    Thread _thread;
+    MemoryPool<Request, MBED_CONF_STM_STSAFE_A110_DISPATCHER_QUEUE_SIZE> _pool;
+    Queue<Request, MBED_CONF_STM_STSAFE_A110_DISPATCHER_QUEUE_SIZE> _queue;
+    STSafeA110Base *_device;
+    uint32_t _idle_ms;
+    bool _hibernated;
+    Mutex _mutex;
+    PowerStats _stats;
+    Kernel::Clock::time_point _state_time;
+};
+
+} // namespace sixtron
+
+#endif // CATIE_SIXTRON_STSAFEA110_DISPATCHER_H_
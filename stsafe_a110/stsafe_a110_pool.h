@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023, CATIE
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CATIE_SIXTRON_STSAFEA110_POOL_H_
+#define CATIE_SIXTRON_STSAFEA110_POOL_H_
+
+#include "mbed.h"
+#include "stsafe_a110/stsafe_a110.h"
+#include "stsafe_a110/stsafe_a110_dispatcher.h"
+
+namespace sixtron {
+
+/*!
+ * Distributes crypto operations over several secure elements.
+ *
+ * Each device is driven by its own started dispatcher, so the devices process commands in
+ * parallel. An operation goes to the eligible device with the fewest commands queued or
+ * running. Operations using a private key can be pinned to the devices holding that key
+ * with set_key_slot_affinity().
+ *
+ * Operations block until completion when no completion callback is given. Otherwise they
+ * return as soon as the command is queued and the completion is called on the dispatcher
+ * thread of the selected device, with the result of the command. A blocking operation made
+ * from a completion and selecting the device of that completion runs inline.
+ */
+class STSafeA110Pool: private NonCopyable<STSafeA110Pool> {
+
+public:
+    /* Called on the dispatcher thread with the result of the operation */
+    typedef Callback<void(int)> Completion;
+
+    struct Utilization {
+        uint32_t commands; /* commands executed */
+        uint32_t errors; /* commands that returned an error */
+        uint32_t outstanding; /* commands queued or running */
+        uint32_t busy_ms; /* time spent executing commands */
+        uint32_t elapsed_ms; /* time since the statistics were reset */
+    };
+
+    STSafeA110Pool();
+
+    /* Add an initialized device and the started dispatcher serializing its commands.
+     * Returns the index of the device, or -1 if the pool is full. */
+    int add(STSafeA110Base *device, STSafeA110Dispatcher *dispatcher);
+
+    /* Only run operations using key_slot on the devices of device_mask (bit n for index n).
+     * All the devices are eligible by default. */
+    int set_key_slot_affinity(uint8_t key_slot, uint32_t device_mask);
+
+    int generate_random(uint8_t *buf, uint8_t length, Completion completion = nullptr);
+
+    int generate_signature(uint8_t key_slot,
+            const uint8_t *digest,
+            StSafeA_HashTypes_t digest_type,
+            uint8_t *r,
+            uint8_t *s,
+            Completion completion = nullptr);
+
+    int establish_key(uint8_t key_slot,
+            const uint8_t *public_x,
+            const uint8_t *public_y,
+            uint16_t length,
+            uint8_t *shared_secret,
+            Completion completion = nullptr);
+
+    int get_utilization(int index, Utilization *utilization);
+
+    void reset_utilization();
+
+private:
+    enum Operation : uint8_t {
+        OperationRandom,
+        OperationSignature,
+        OperationEstablishKey,
+    };
+
+    struct Job {
+        STSafeA110Pool *pool;
+        uint8_t device;
+        Operation operation;
+        uint8_t key_slot;
+        StSafeA_HashTypes_t digest_type;
+        uint16_t length;
+        const uint8_t *input_1;
+        const uint8_t *input_2;
+        uint8_t *output_1;
+        uint8_t *output_2;
+        Completion completion;
+        Semaphore *done;
+        int *result;
+
+        int run();
+    };
+
+    struct Device {
+        STSafeA110Base *device;
+        STSafeA110Dispatcher *dispatcher;
+        uint32_t outstanding;
+        uint32_t commands;
+        uint32_t errors;
+        uint32_t busy_ms;
+    };
+
+    /* Private key slots 0, 1 and ephemeral */
+    static const uint8_t KeySlotNumber = 3;
+
+    static int key_slot_index(uint8_t key_slot);
+
+    int submit(const Job &job, uint32_t device_mask);
+
+    int execute(Job *job);
+
+    Mutex _mutex;
+    Device _devices[MBED_CONF_STM_STSAFE_A110_POOL_MAX_DEVICES];
+    uint8_t _device_number;
+    uint8_t _next;
+    uint32_t _key_slot_affinity[KeySlotNumber];
+    Kernel::Clock::time_point _reset_time;
+    MemoryPool<Job, MBED_CONF_STM_STSAFE_A110_POOL_QUEUE_SIZE> _jobs;
+};
+
+} // namespace sixtron
+
+#endif // CATIE_SIXTRON_STSAFEA110_POOL_H_